@@ -355,8 +355,8 @@ static void yynoreturn yy_fatal_error ( const char* msg  );
 	(yy_hold_char) = *yy_cp; \
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 20
-#define YY_END_OF_BUFFER 21
+#define YY_NUM_RULES 21
+#define YY_END_OF_BUFFER 22
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -364,14 +364,15 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[60] =
+static const flex_int16_t yy_accept[66] =
     {   0,
-        0,    0,   21,   19,   18,   18,   19,   19,   19,   19,
-       16,   19,   19,   19,   15,   15,   15,   15,   15,   15,
-       19,   18,   10,   13,   17,    0,    1,    0,   16,   11,
-        9,   12,   15,   15,   15,    5,   15,   15,   15,   14,
-        0,    0,    1,   16,   15,   15,    3,   15,   15,    2,
-       15,    6,   15,   15,   15,    8,    7,    4,    0
+        0,    0,   22,   20,   19,   19,   20,   20,   20,   20,
+       17,   20,   20,   20,   16,   16,   16,   16,   16,   16,
+       20,   19,   11,   14,   18,    0,    1,    0,   17,   12,
+       10,   13,   16,   16,   16,    5,   16,   16,   16,   15,
+        0,    0,    1,   17,   16,   16,    3,   16,   16,    2,
+       16,    6,   16,   16,   16,    8,    7,    4,   16,   16,
+       16,   16,   16,    9,    0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -413,60 +414,62 @@ static const YY_CHAR yy_meta[30] =
         3,    3,    3,    3,    3,    3,    3,    3,    1
     } ;
 
-static const flex_int16_t yy_base[63] =
+static const flex_int16_t yy_base[69] =
     {   0,
         0,    0,   81,   82,   28,   30,   69,   74,   69,   28,
        28,   66,   65,   64,    0,   52,   53,   21,   48,   53,
        41,   37,   82,   82,   60,   62,    0,   58,   34,   82,
        82,   82,    0,   39,   40,    0,   38,   44,   43,   82,
        55,   38,    0,   51,   45,   42,    0,   36,   36,   82,
-       35,    0,   28,   37,   35,    0,    0,    0,   82,   42,
-       46,   49
+       35,    0,   28,   37,   35,    0,    0,    0,   96,   87,
+       87,   91,   95,    0,   82,   42,   46,   49
     } ;
 
-static const flex_int16_t yy_def[63] =
+static const flex_int16_t yy_def[69] =
     {   0,
-       59,    1,   59,   59,   59,   59,   59,   59,   59,   59,
-       59,   59,   59,   59,   60,   60,   60,   60,   60,   60,
-       59,   59,   59,   59,   59,   61,   62,   59,   59,   59,
-       59,   59,   60,   60,   60,   60,   60,   60,   60,   59,
-       61,   61,   62,   59,   60,   60,   60,   60,   60,   59,
-       60,   60,   60,   60,   60,   60,   60,   60,    0,   59,
-       59,   59
+       65,    1,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   66,   66,   66,   66,   66,   66,
+       65,   65,   65,   65,   65,   67,   68,   65,   65,   65,
+       65,   65,   66,   66,   66,   66,   66,   66,   66,   65,
+       67,   67,   68,   65,   66,   66,   66,   66,   66,   65,
+       66,   66,   66,   66,   66,   66,   66,   66,   66,   66,
+       66,   66,   66,   66,    0,   65,   65,   65
     } ;
 
-static const flex_int16_t yy_nxt[112] =
+static const flex_int16_t yy_nxt[126] =
     {   0,
         4,    5,    6,    7,    8,    4,    9,   10,   11,   12,
        13,   14,   15,   15,   16,   17,   15,   15,   18,   15,
-       15,   15,   19,   15,   15,   15,   15,   20,   21,   22,
+       15,   15,   19,   59,   15,   15,   15,   20,   21,   22,
        22,   22,   22,   26,   28,   27,   29,   36,   22,   22,
        28,   37,   29,   42,   33,   50,   41,   41,   41,   43,
        58,   43,   57,   56,   55,   54,   53,   52,   51,   44,
        42,   49,   48,   47,   46,   45,   44,   42,   25,   40,
        39,   38,   35,   34,   32,   31,   30,   25,   24,   23,
-       59,    3,   59,   59,   59,   59,   59,   59,   59,   59,
-       59,   59,   59,   59,   59,   59,   59,   59,   59,   59,
+       65,    3,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
 
-       59,   59,   59,   59,   59,   59,   59,   59,   59,   59,
-       59
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   60,   61,   62,   63,   64,    0,    0,    0,    0,
+        0,    0,    0,    0,    0
     } ;
 
-static const flex_int16_t yy_chk[112] =
+static const flex_int16_t yy_chk[126] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    5,
         5,    6,    6,   10,   11,   10,   11,   18,   22,   22,
-       29,   18,   29,   42,   60,   42,   61,   61,   61,   62,
-       55,   62,   54,   53,   51,   49,   48,   46,   45,   44,
+       29,   18,   29,   42,   66,   42,   67,   67,   67,   68,
+       55,   68,   54,   53,   51,   49,   48,   46,   45,   44,
        41,   39,   38,   37,   35,   34,   28,   26,   25,   21,
        20,   19,   17,   16,   14,   13,   12,    9,    8,    7,
-        3,   59,   59,   59,   59,   59,   59,   59,   59,   59,
-       59,   59,   59,   59,   59,   59,   59,   59,   59,   59,
+        3,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
 
-       59,   59,   59,   59,   59,   59,   59,   59,   59,   59,
-       59
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   59,   60,   61,   62,   63,    0,    0,    0,    0,
+        0,    0,    0,    0,    0
     } ;
 
 static yy_state_type yy_last_accepting_state;
@@ -492,8 +495,8 @@ char *yytext;
 #include <cstring>
 #include <string>
 #include "../generated/parser.hpp"  //  + yylval
-#line 495 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
-#line 496 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
+#line 498 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
+#line 499 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
 
 #define INITIAL 0
 
@@ -710,7 +713,7 @@ YY_DECL
 	{
 #line 18 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
 
-#line 713 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
+#line 716 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -737,13 +740,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 60 )
+				if ( yy_current_state >= 66 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 			++yy_cp;
 			}
-		while ( yy_current_state != 59 );
+		while ( yy_current_state != 65 );
 		yy_cp = (yy_last_accepting_cpos);
 		yy_current_state = (yy_last_accepting_state);
 
@@ -806,43 +809,43 @@ YY_RULE_SETUP
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 29 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return EQ; }
+#line 28 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ return KW_RETURN; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
 #line 30 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return NE; }
+{ return EQ; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
 #line 31 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return LE; }
+{ return NE; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
 #line 32 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return GE; }
+{ return LE; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
 #line 33 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return AND; }
+{ return GE; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
 #line 34 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return OR; }
+{ return AND; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 36 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ yylval.str = new std::string(yytext); return IDENT; }
+#line 35 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ return OR; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 38 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ yylval.num = std::strtod(yytext, nullptr); return NUMBER; }
+#line 37 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ yylval.str = new std::string(yytext); return IDENT; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
@@ -850,22 +853,27 @@ YY_RULE_SETUP
 { yylval.num = std::strtod(yytext, nullptr); return NUMBER; }
 	YY_BREAK
 case 18:
-/* rule 18 can match eol */
 YY_RULE_SETUP
-#line 41 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ /*  */ }
+#line 40 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ yylval.num = std::strtod(yytext, nullptr); return NUMBER; }
 	YY_BREAK
 case 19:
+/* rule 19 can match eol */
 YY_RULE_SETUP
-#line 43 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
-{ return yytext[0]; }
+#line 42 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ /*  */ }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
 #line 44 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+{ return yytext[0]; }
+	YY_BREAK
+case 21:
+YY_RULE_SETUP
+#line 45 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
 ECHO;
 	YY_BREAK
-#line 868 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
+#line 876 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\lexer.cpp"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1163,7 +1171,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 60 )
+			if ( yy_current_state >= 66 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
@@ -1191,11 +1199,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 60 )
+		if ( yy_current_state >= 66 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 59);
+	yy_is_jam = (yy_current_state == 65);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -1834,6 +1842,6 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 44 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
+#line 45 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\lexer.l"
 
 
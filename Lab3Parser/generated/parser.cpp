@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.7.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -46,10 +46,10 @@
    USER NAME SPACE" below.  */
 
 /* Identify Bison output, and Bison version.  */
-#define YYBISON 30704
+#define YYBISON 30802
 
 /* Bison version string.  */
-#define YYBISON_VERSION "3.7.4"
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -78,10 +78,13 @@
 //   AST (Block)
 AST::Block* g_root = nullptr;
 
+//   ,   AST::resolve (, ); 0    
+int g_resolveNodes = 0;
+
 int yylex(void);
 void yyerror(const char* s);
 
-#line 85 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 88 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -118,41 +121,53 @@ enum yysymbol_kind_t
   YYSYMBOL_KW_ELSE = 6,                    /* KW_ELSE  */
   YYSYMBOL_KW_WHILE = 7,                   /* KW_WHILE  */
   YYSYMBOL_KW_PRINT = 8,                   /* KW_PRINT  */
-  YYSYMBOL_IDENT = 9,                      /* IDENT  */
-  YYSYMBOL_NUMBER = 10,                    /* NUMBER  */
-  YYSYMBOL_EQ = 11,                        /* EQ  */
-  YYSYMBOL_NE = 12,                        /* NE  */
-  YYSYMBOL_LE = 13,                        /* LE  */
-  YYSYMBOL_GE = 14,                        /* GE  */
-  YYSYMBOL_AND = 15,                       /* AND  */
-  YYSYMBOL_OR = 16,                        /* OR  */
-  YYSYMBOL_17_ = 17,                       /* '='  */
-  YYSYMBOL_18_ = 18,                       /* '<'  */
-  YYSYMBOL_19_ = 19,                       /* '>'  */
-  YYSYMBOL_20_ = 20,                       /* '+'  */
-  YYSYMBOL_21_ = 21,                       /* '-'  */
-  YYSYMBOL_22_ = 22,                       /* '*'  */
-  YYSYMBOL_23_ = 23,                       /* '/'  */
-  YYSYMBOL_24_ = 24,                       /* '%'  */
-  YYSYMBOL_UMINUS = 25,                    /* UMINUS  */
-  YYSYMBOL_26_ = 26,                       /* '!'  */
-  YYSYMBOL_LOWER_THAN_ELSE = 27,           /* LOWER_THAN_ELSE  */
-  YYSYMBOL_28_ = 28,                       /* ';'  */
-  YYSYMBOL_29_ = 29,                       /* '{'  */
-  YYSYMBOL_30_ = 30,                       /* '}'  */
-  YYSYMBOL_31_ = 31,                       /* '('  */
-  YYSYMBOL_32_ = 32,                       /* ')'  */
-  YYSYMBOL_YYACCEPT = 33,                  /* $accept  */
-  YYSYMBOL_program = 34,                   /* program  */
-  YYSYMBOL_stmts = 35,                     /* stmts  */
-  YYSYMBOL_stmt = 36,                      /* stmt  */
-  YYSYMBOL_block = 37,                     /* block  */
-  YYSYMBOL_vardecl = 38,                   /* vardecl  */
-  YYSYMBOL_assign = 39,                    /* assign  */
-  YYSYMBOL_print = 40,                     /* print  */
-  YYSYMBOL_if = 41,                        /* if  */
-  YYSYMBOL_while = 42,                     /* while  */
-  YYSYMBOL_expr = 43                       /* expr  */
+  YYSYMBOL_KW_RETURN = 9,                  /* KW_RETURN  */
+  YYSYMBOL_IDENT = 10,                     /* IDENT  */
+  YYSYMBOL_NUMBER = 11,                    /* NUMBER  */
+  YYSYMBOL_EQ = 12,                        /* EQ  */
+  YYSYMBOL_NE = 13,                        /* NE  */
+  YYSYMBOL_LE = 14,                        /* LE  */
+  YYSYMBOL_GE = 15,                        /* GE  */
+  YYSYMBOL_AND = 16,                       /* AND  */
+  YYSYMBOL_OR = 17,                        /* OR  */
+  YYSYMBOL_18_ = 18,                       /* '='  */
+  YYSYMBOL_19_ = 19,                       /* '<'  */
+  YYSYMBOL_20_ = 20,                       /* '>'  */
+  YYSYMBOL_21_ = 21,                       /* '+'  */
+  YYSYMBOL_22_ = 22,                       /* '-'  */
+  YYSYMBOL_23_ = 23,                       /* '*'  */
+  YYSYMBOL_24_ = 24,                       /* '/'  */
+  YYSYMBOL_25_ = 25,                       /* '%'  */
+  YYSYMBOL_UMINUS = 26,                    /* UMINUS  */
+  YYSYMBOL_27_ = 27,                       /* '!'  */
+  YYSYMBOL_LOWER_THAN_ELSE = 28,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_29_ = 29,                       /* ';'  */
+  YYSYMBOL_30_ = 30,                       /* '{'  */
+  YYSYMBOL_31_ = 31,                       /* '}'  */
+  YYSYMBOL_32_ = 32,                       /* '['  */
+  YYSYMBOL_33_ = 33,                       /* ']'  */
+  YYSYMBOL_34_ = 34,                       /* '('  */
+  YYSYMBOL_35_ = 35,                       /* ')'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_YYACCEPT = 37,                  /* $accept  */
+  YYSYMBOL_program = 38,                   /* program  */
+  YYSYMBOL_items = 39,                     /* items  */
+  YYSYMBOL_stmts = 40,                     /* stmts  */
+  YYSYMBOL_stmt = 41,                      /* stmt  */
+  YYSYMBOL_block = 42,                     /* block  */
+  YYSYMBOL_vardecl = 43,                   /* vardecl  */
+  YYSYMBOL_funcdef = 44,                   /* funcdef  */
+  YYSYMBOL_params = 45,                    /* params  */
+  YYSYMBOL_paramlist = 46,                 /* paramlist  */
+  YYSYMBOL_return = 47,                    /* return  */
+  YYSYMBOL_call = 48,                      /* call  */
+  YYSYMBOL_args = 49,                      /* args  */
+  YYSYMBOL_arglist = 50,                   /* arglist  */
+  YYSYMBOL_assign = 51,                    /* assign  */
+  YYSYMBOL_print = 52,                     /* print  */
+  YYSYMBOL_if = 53,                        /* if  */
+  YYSYMBOL_while = 54,                     /* while  */
+  YYSYMBOL_expr = 55                       /* expr  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -196,6 +211,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -257,7 +284,7 @@ typedef int yytype_uint16;
 
 
 /* Stored state numbers (used for stacks). */
-typedef yytype_int8 yy_state_t;
+typedef yytype_uint8 yy_state_t;
 
 /* State numbers in computations.  */
 typedef int yy_state_fast_t;
@@ -293,17 +320,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -462,19 +495,19 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   180
+#define YYLAST   288
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  33
+#define YYNTOKENS  37
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  11
+#define YYNNTS  19
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  38
+#define YYNRULES  63
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  79
+#define YYNSTATES  132
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   273
+#define YYMAXUTOK   274
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -491,16 +524,16 @@ static const yytype_int8 yytranslate[] =
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,    26,     2,     2,     2,    24,     2,     2,
-      31,    32,    22,    20,     2,    21,     2,    23,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    28,
-      18,    17,    19,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    27,     2,     2,     2,    25,     2,     2,
+      34,    35,    23,    21,    36,    22,     2,    24,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    29,
+      19,    18,    20,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    32,     2,    33,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,    29,     2,    30,     2,     2,     2,     2,
+       2,     2,     2,    30,     2,    31,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -515,17 +548,20 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    16,    25,    27
+      15,    16,    17,    26,    28
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    61,    61,    65,    66,    70,    71,    72,    73,    74,
-      75,    79,    84,    85,    86,    87,    92,    97,   102,   104,
-     109,   115,   116,   117,   118,   119,   120,   121,   122,   123,
-     124,   125,   126,   127,   128,   129,   130,   131,   132
+       0,    70,    70,    75,    76,    77,    81,    82,    86,    87,
+      88,    89,    90,    91,    92,    93,    97,   102,   103,   104,
+     105,   106,   107,   112,   114,   119,   120,   124,   125,   126,
+     127,   131,   132,   136,   140,   141,   145,   146,   151,   152,
+     157,   162,   164,   169,   175,   176,   177,   178,   179,   180,
+     181,   182,   183,   184,   185,   186,   187,   188,   189,   190,
+     191,   192,   193,   194
 };
 #endif
 
@@ -542,11 +578,13 @@ static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 static const char *const yytname[] =
 {
   "\"end of file\"", "error", "\"invalid token\"", "KW_INT", "KW_DOUBLE",
-  "KW_IF", "KW_ELSE", "KW_WHILE", "KW_PRINT", "IDENT", "NUMBER", "EQ",
-  "NE", "LE", "GE", "AND", "OR", "'='", "'<'", "'>'", "'+'", "'-'", "'*'",
-  "'/'", "'%'", "UMINUS", "'!'", "LOWER_THAN_ELSE", "';'", "'{'", "'}'",
-  "'('", "')'", "$accept", "program", "stmts", "stmt", "block", "vardecl",
-  "assign", "print", "if", "while", "expr", YY_NULLPTR
+  "KW_IF", "KW_ELSE", "KW_WHILE", "KW_PRINT", "KW_RETURN", "IDENT",
+  "NUMBER", "EQ", "NE", "LE", "GE", "AND", "OR", "'='", "'<'", "'>'",
+  "'+'", "'-'", "'*'", "'/'", "'%'", "UMINUS", "'!'", "LOWER_THAN_ELSE",
+  "';'", "'{'", "'}'", "'['", "']'", "'('", "')'", "','", "$accept",
+  "program", "items", "stmts", "stmt", "block", "vardecl", "funcdef",
+  "params", "paramlist", "return", "call", "args", "arglist", "assign",
+  "print", "if", "while", "expr", YY_NULLPTR
 };
 
 static const char *
@@ -556,19 +594,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
-{
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,    61,    60,    62,
-      43,    45,    42,    47,    37,   272,    33,   273,    59,   123,
-     125,    40,    41
-};
-#endif
-
-#define YYPACT_NINF (-56)
+#define YYPACT_NINF (-83)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -578,128 +604,172 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     -56,     5,    39,   -56,    -3,     0,   -14,   -10,    -8,    -7,
-     -56,   -56,   -56,    17,    22,    27,   -56,   -56,    40,    41,
-      28,    28,    28,    28,    11,   -56,   -56,   -56,    28,    28,
-     -56,   -56,    28,    28,    28,    51,    66,    81,   111,   -56,
-     111,   111,   -56,   -56,    96,    28,    28,    28,    28,    28,
-      28,    28,    28,    28,    28,    28,    28,    28,    39,    39,
-     -56,   -56,   151,   151,   156,   156,   139,   125,   156,   156,
-      29,    29,   -56,   -56,   -56,    33,   -56,    39,   -56
+     -83,     4,    58,   -83,    40,    46,   -22,    30,    38,    -8,
+      -9,   -83,   -83,   -83,    63,   -83,   -83,    68,    69,    71,
+     -83,   -83,    -3,    59,    72,    72,    72,    -4,   -83,    72,
+      72,   -83,    72,   -83,   200,    72,    72,    72,    50,   -83,
+     -83,   -83,   -83,    72,    84,    75,    72,    90,    75,    95,
+     119,   136,    72,   -83,   -83,   153,    72,    72,    72,    72,
+      72,    72,    72,    72,    72,    72,    72,    72,    72,   -83,
+     218,   170,    78,    85,   218,   112,   113,   -83,   -83,   218,
+      91,   116,   117,    93,   101,   218,    96,   110,    66,    66,
+     -83,   185,   -83,   258,   258,   263,   263,   246,   232,   263,
+     263,    80,    80,   -83,   -83,   -83,   128,   -83,    72,   -10,
+       2,   -83,   -83,   -83,   132,    81,   -83,   132,   141,   -83,
+     -83,    72,   218,   -83,   154,   169,   -83,    66,   218,   -83,
+     -83,   -83
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        3,     0,     2,     1,     0,     0,     0,     0,     0,     0,
-       3,     4,    10,     0,     0,     0,     8,     9,    12,    13,
-       0,     0,     0,     0,     0,     5,     6,     7,     0,     0,
-      38,    37,     0,     0,     0,     0,     0,     0,    16,    11,
-      14,    15,    34,    35,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      17,    36,    30,    31,    27,    29,    32,    33,    26,    28,
-      21,    22,    23,    24,    25,    18,    20,     0,    19
+       0,     6,     4,    13,     0,     5,    14,     0,     0,     0,
+      11,    12,    17,    18,     0,     0,     0,    61,    60,     0,
+       0,    32,     0,    63,     0,     0,     0,    34,     0,     8,
+      15,     9,    10,     0,     0,    25,     0,     0,    25,     0,
+       0,     0,     0,    57,    58,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    31,
+      38,     0,     0,    35,    36,     0,     0,    16,     7,    19,
+       0,     0,     0,     0,    26,    20,     0,     0,     0,     0,
+      40,     0,    59,    53,    54,    50,    52,    55,    56,    49,
+      51,    44,    45,    46,    47,    48,     0,    33,     0,    17,
+      18,    21,    27,    28,     0,     0,    22,     0,    41,    43,
+      62,     0,    37,    23,     0,     0,    24,     0,    39,    29,
+      30,    42
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -56,   -56,    46,   -55,   -56,   -56,   -56,   -56,   -56,   -56,
-     -21
+     -83,   -83,   -83,   -83,   -37,   -82,   -83,   -83,   115,   -83,
+     -83,    -2,   -83,   -83,   -83,   -83,   -83,   -83,   -19
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     1,     2,    11,    12,    13,    14,    15,    16,    17,
-      35
+       0,     1,     2,    38,    12,    13,    14,    15,    83,    84,
+      16,    33,    72,    73,    18,    19,    20,    21,    34
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_int8 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_uint8 yytable[] =
 {
-      36,    37,    38,    75,    76,     3,    18,    40,    41,    19,
-      23,    42,    43,    44,     4,     5,     6,    20,     7,     8,
-       9,    21,    78,    22,    62,    63,    64,    65,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    30,    31,    77,
-      10,    39,     4,     5,     6,    25,     7,     8,     9,    32,
-      26,    55,    56,    57,    33,    27,    24,    28,    29,    34,
-       0,     0,    45,    46,    47,    48,    49,    50,    10,    51,
-      52,    53,    54,    55,    56,    57,     0,    45,    46,    47,
-      48,    49,    50,    58,    51,    52,    53,    54,    55,    56,
-      57,     0,    45,    46,    47,    48,    49,    50,    59,    51,
-      52,    53,    54,    55,    56,    57,     0,    45,    46,    47,
-      48,    49,    50,    60,    51,    52,    53,    54,    55,    56,
-      57,     0,    45,    46,    47,    48,    49,    50,    61,    51,
-      52,    53,    54,    55,    56,    57,    45,    46,    47,    48,
-      49,     0,     0,    51,    52,    53,    54,    55,    56,    57,
-      45,    46,    47,    48,     0,     0,     0,    51,    52,    53,
-      54,    55,    56,    57,    47,    48,     0,     0,     0,    51,
-      52,    53,    54,    55,    56,    57,    53,    54,    55,    56,
-      57
+      17,    78,    27,    28,     3,    49,    50,    51,    43,    35,
+      53,    54,    24,    55,    29,    43,    70,    71,    74,    30,
+      46,    31,    44,    36,    79,    37,    32,    85,    52,    44,
+      37,    45,   123,    91,    47,   126,    17,    93,    94,    95,
+      96,    97,    98,    99,   100,   101,   102,   103,   104,   105,
+      22,   118,   119,    75,    76,     6,    23,     7,     8,     9,
+      10,     4,     5,     6,    25,     7,     8,     9,    10,    75,
+      76,     6,    26,     7,     8,     9,    10,    46,    81,    82,
+      11,    77,    27,    28,   124,   125,    17,    17,    11,   122,
+     131,    47,    39,    48,    29,    80,    11,    40,    41,    30,
+      42,    86,   128,    66,    67,    68,    32,    56,    57,    58,
+      59,    60,    61,   107,    62,    63,    64,    65,    66,    67,
+      68,   108,   109,   110,   111,    17,   112,   113,   114,   116,
+      88,    56,    57,    58,    59,    60,    61,   115,    62,    63,
+      64,    65,    66,    67,    68,   117,   121,   127,    56,    57,
+      58,    59,    60,    61,    89,    62,    63,    64,    65,    66,
+      67,    68,    11,    87,   129,    56,    57,    58,    59,    60,
+      61,    90,    62,    63,    64,    65,    66,    67,    68,   130,
+       0,     0,    56,    57,    58,    59,    60,    61,    92,    62,
+      63,    64,    65,    66,    67,    68,     0,    56,    57,    58,
+      59,    60,    61,   106,    62,    63,    64,    65,    66,    67,
+      68,     0,    56,    57,    58,    59,    60,    61,   120,    62,
+      63,    64,    65,    66,    67,    68,     0,     0,     0,    69,
+      56,    57,    58,    59,    60,    61,     0,    62,    63,    64,
+      65,    66,    67,    68,    56,    57,    58,    59,    60,     0,
+       0,    62,    63,    64,    65,    66,    67,    68,    56,    57,
+      58,    59,     0,     0,     0,    62,    63,    64,    65,    66,
+      67,    68,    58,    59,     0,     0,     0,    62,    63,    64,
+      65,    66,    67,    68,    64,    65,    66,    67,    68
 };
 
 static const yytype_int8 yycheck[] =
 {
-      21,    22,    23,    58,    59,     0,     9,    28,    29,     9,
-      17,    32,    33,    34,     3,     4,     5,    31,     7,     8,
-       9,    31,    77,    31,    45,    46,    47,    48,    49,    50,
-      51,    52,    53,    54,    55,    56,    57,     9,    10,     6,
-      29,    30,     3,     4,     5,    28,     7,     8,     9,    21,
-      28,    22,    23,    24,    26,    28,    10,    17,    17,    31,
-      -1,    -1,    11,    12,    13,    14,    15,    16,    29,    18,
-      19,    20,    21,    22,    23,    24,    -1,    11,    12,    13,
-      14,    15,    16,    32,    18,    19,    20,    21,    22,    23,
-      24,    -1,    11,    12,    13,    14,    15,    16,    32,    18,
-      19,    20,    21,    22,    23,    24,    -1,    11,    12,    13,
-      14,    15,    16,    32,    18,    19,    20,    21,    22,    23,
-      24,    -1,    11,    12,    13,    14,    15,    16,    32,    18,
-      19,    20,    21,    22,    23,    24,    11,    12,    13,    14,
-      15,    -1,    -1,    18,    19,    20,    21,    22,    23,    24,
-      11,    12,    13,    14,    -1,    -1,    -1,    18,    19,    20,
-      21,    22,    23,    24,    13,    14,    -1,    -1,    -1,    18,
-      19,    20,    21,    22,    23,    24,    20,    21,    22,    23,
-      24
+       2,    38,    10,    11,     0,    24,    25,    26,    18,    18,
+      29,    30,    34,    32,    22,    18,    35,    36,    37,    27,
+      18,    29,    32,    32,    43,    34,    34,    46,    32,    32,
+      34,    34,   114,    52,    32,   117,    38,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      10,    88,    89,     3,     4,     5,    10,     7,     8,     9,
+      10,     3,     4,     5,    34,     7,     8,     9,    10,     3,
+       4,     5,    34,     7,     8,     9,    10,    18,     3,     4,
+      30,    31,    10,    11,     3,     4,    88,    89,    30,   108,
+     127,    32,    29,    34,    22,    11,    30,    29,    29,    27,
+      29,    11,   121,    23,    24,    25,    34,    12,    13,    14,
+      15,    16,    17,    35,    19,    20,    21,    22,    23,    24,
+      25,    36,    10,    10,    33,   127,    10,    10,    35,    33,
+      35,    12,    13,    14,    15,    16,    17,    36,    19,    20,
+      21,    22,    23,    24,    25,    35,    18,     6,    12,    13,
+      14,    15,    16,    17,    35,    19,    20,    21,    22,    23,
+      24,    25,    30,    48,    10,    12,    13,    14,    15,    16,
+      17,    35,    19,    20,    21,    22,    23,    24,    25,    10,
+      -1,    -1,    12,    13,    14,    15,    16,    17,    35,    19,
+      20,    21,    22,    23,    24,    25,    -1,    12,    13,    14,
+      15,    16,    17,    33,    19,    20,    21,    22,    23,    24,
+      25,    -1,    12,    13,    14,    15,    16,    17,    33,    19,
+      20,    21,    22,    23,    24,    25,    -1,    -1,    -1,    29,
+      12,    13,    14,    15,    16,    17,    -1,    19,    20,    21,
+      22,    23,    24,    25,    12,    13,    14,    15,    16,    -1,
+      -1,    19,    20,    21,    22,    23,    24,    25,    12,    13,
+      14,    15,    -1,    -1,    -1,    19,    20,    21,    22,    23,
+      24,    25,    14,    15,    -1,    -1,    -1,    19,    20,    21,
+      22,    23,    24,    25,    21,    22,    23,    24,    25
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,    34,    35,     0,     3,     4,     5,     7,     8,     9,
-      29,    36,    37,    38,    39,    40,    41,    42,     9,     9,
-      31,    31,    31,    17,    35,    28,    28,    28,    17,    17,
-       9,    10,    21,    26,    31,    43,    43,    43,    43,    30,
-      43,    43,    43,    43,    43,    11,    12,    13,    14,    15,
-      16,    18,    19,    20,    21,    22,    23,    24,    32,    32,
-      32,    32,    43,    43,    43,    43,    43,    43,    43,    43,
-      43,    43,    43,    43,    43,    36,    36,     6,    36
+       0,    38,    39,     0,     3,     4,     5,     7,     8,     9,
+      10,    30,    41,    42,    43,    44,    47,    48,    51,    52,
+      53,    54,    10,    10,    34,    34,    34,    10,    11,    22,
+      27,    29,    34,    48,    55,    18,    32,    34,    40,    29,
+      29,    29,    29,    18,    32,    34,    18,    32,    34,    55,
+      55,    55,    32,    55,    55,    55,    12,    13,    14,    15,
+      16,    17,    19,    20,    21,    22,    23,    24,    25,    29,
+      55,    55,    49,    50,    55,     3,     4,    31,    41,    55,
+      11,     3,     4,    45,    46,    55,    11,    45,    35,    35,
+      35,    55,    35,    55,    55,    55,    55,    55,    55,    55,
+      55,    55,    55,    55,    55,    55,    33,    35,    36,    10,
+      10,    33,    10,    10,    35,    36,    33,    35,    41,    41,
+      33,    18,    55,    42,     3,     4,    42,     6,    55,    10,
+      10,    41
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    33,    34,    35,    35,    36,    36,    36,    36,    36,
-      36,    37,    38,    38,    38,    38,    39,    40,    41,    41,
-      42,    43,    43,    43,    43,    43,    43,    43,    43,    43,
-      43,    43,    43,    43,    43,    43,    43,    43,    43
+       0,    37,    38,    39,    39,    39,    40,    40,    41,    41,
+      41,    41,    41,    41,    41,    41,    42,    43,    43,    43,
+      43,    43,    43,    44,    44,    45,    45,    46,    46,    46,
+      46,    47,    47,    48,    49,    49,    50,    50,    51,    51,
+      52,    53,    53,    54,    55,    55,    55,    55,    55,    55,
+      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
+      55,    55,    55,    55
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
-       0,     2,     1,     0,     2,     2,     2,     2,     1,     1,
-       1,     3,     2,     2,     4,     4,     3,     4,     5,     7,
-       5,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     2,     2,     3,     1,     1
+       0,     2,     1,     0,     2,     2,     0,     2,     2,     2,
+       2,     1,     1,     1,     1,     2,     3,     2,     2,     4,
+       4,     5,     5,     6,     6,     0,     1,     2,     2,     4,
+       4,     3,     2,     4,     0,     1,     1,     3,     3,     6,
+       4,     5,     7,     5,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     2,     2,     3,
+       1,     1,     4,     1
 };
 
 
@@ -711,6 +781,7 @@ enum { YYENOMEM = -2 };
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -751,10 +822,7 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-# ifndef YY_LOCATION_PRINT
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
+
 
 
 # define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
@@ -778,15 +846,11 @@ yy_symbol_value_print (FILE *yyo,
                        yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yykind < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yykind], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yykind);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -900,13 +964,13 @@ static void
 yydestruct (const char *yymsg,
             yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yykind);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -969,6 +1033,7 @@ yyparse (void)
   YYDPRINTF ((stderr, "Starting parse\n"));
 
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -994,7 +1059,7 @@ yysetstate:
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1022,7 +1087,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1033,7 +1098,7 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1055,6 +1120,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1166,230 +1232,380 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2: /* program: stmts  */
-#line 61 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 2: /* program: items  */
+#line 70 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { g_root = (yyvsp[0].block); }
-#line 1173 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1239 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 3: /* stmts: %empty  */
-#line 65 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 3: /* items: %empty  */
+#line 75 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.block) = new AST::Block(); }
-#line 1179 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1245 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 4: /* stmts: stmts stmt  */
-#line 66 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 4: /* items: items stmt  */
+#line 76 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyvsp[-1].block)->add((yyvsp[0].stmt)); (yyval.block) = (yyvsp[-1].block); }
-#line 1185 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1251 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 5: /* stmt: vardecl ';'  */
-#line 70 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 5: /* items: items funcdef  */
+#line 77 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyvsp[-1].block)->add((yyvsp[0].stmt)); (yyval.block) = (yyvsp[-1].block); }
+#line 1257 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 6: /* stmts: %empty  */
+#line 81 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.block) = new AST::Block(); }
+#line 1263 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 7: /* stmts: stmts stmt  */
+#line 82 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyvsp[-1].block)->add((yyvsp[0].stmt)); (yyval.block) = (yyvsp[-1].block); }
+#line 1269 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 8: /* stmt: vardecl ';'  */
+#line 86 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1191 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1275 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 6: /* stmt: assign ';'  */
-#line 71 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 9: /* stmt: assign ';'  */
+#line 87 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1197 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1281 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 7: /* stmt: print ';'  */
-#line 72 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 10: /* stmt: print ';'  */
+#line 88 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1203 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1287 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 8: /* stmt: if  */
-#line 73 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 11: /* stmt: if  */
+#line 89 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                               { (yyval.stmt) = (yyvsp[0].stmt); }
-#line 1209 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1293 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 9: /* stmt: while  */
-#line 74 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 12: /* stmt: while  */
+#line 90 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                               { (yyval.stmt) = (yyvsp[0].stmt); }
-#line 1215 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1299 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 10: /* stmt: block  */
-#line 75 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 13: /* stmt: block  */
+#line 91 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                              { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 1305 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 14: /* stmt: return  */
+#line 92 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                               { (yyval.stmt) = (yyvsp[0].stmt); }
-#line 1221 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1311 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 15: /* stmt: call ';'  */
+#line 93 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.stmt) = new AST::ExprStmt((yyvsp[-1].expr)); }
+#line 1317 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 11: /* block: '{' stmts '}'  */
-#line 79 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 16: /* block: '{' stmts '}'  */
+#line 97 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyvsp[-1].block)->setScoped(true); (yyval.stmt) = (yyvsp[-1].block); }
-#line 1227 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1323 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 12: /* vardecl: KW_INT IDENT  */
-#line 84 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 17: /* vardecl: KW_INT IDENT  */
+#line 102 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = new AST::VarDecl(AST::Type::Int, *(yyvsp[0].str)); delete (yyvsp[0].str); }
-#line 1233 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1329 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 13: /* vardecl: KW_DOUBLE IDENT  */
-#line 85 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 18: /* vardecl: KW_DOUBLE IDENT  */
+#line 103 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = new AST::VarDecl(AST::Type::Double, *(yyvsp[0].str)); delete (yyvsp[0].str); }
-#line 1239 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1335 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 14: /* vardecl: KW_INT IDENT '=' expr  */
-#line 86 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 19: /* vardecl: KW_INT IDENT '=' expr  */
+#line 104 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = new AST::VarDecl(AST::Type::Int, *(yyvsp[-2].str), (yyvsp[0].expr)); delete (yyvsp[-2].str); }
-#line 1245 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1341 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 15: /* vardecl: KW_DOUBLE IDENT '=' expr  */
-#line 87 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 20: /* vardecl: KW_DOUBLE IDENT '=' expr  */
+#line 105 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                                { (yyval.stmt) = new AST::VarDecl(AST::Type::Double, *(yyvsp[-2].str), (yyvsp[0].expr)); delete (yyvsp[-2].str); }
-#line 1251 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1347 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 16: /* assign: IDENT '=' expr  */
-#line 92 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 21: /* vardecl: KW_INT IDENT '[' NUMBER ']'  */
+#line 106 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                                     { (yyval.stmt) = new AST::ArrayDecl(AST::Type::Int, *(yyvsp[-3].str), (yyvsp[-1].num)); delete (yyvsp[-3].str); ++g_resolveNodes; }
+#line 1353 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 22: /* vardecl: KW_DOUBLE IDENT '[' NUMBER ']'  */
+#line 107 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                                     { (yyval.stmt) = new AST::ArrayDecl(AST::Type::Double, *(yyvsp[-3].str), (yyvsp[-1].num)); delete (yyvsp[-3].str); ++g_resolveNodes; }
+#line 1359 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 23: /* funcdef: KW_INT IDENT '(' params ')' block  */
+#line 113 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+        { (yyval.stmt) = new AST::Function(AST::Type::Int, *(yyvsp[-4].str), (yyvsp[-2].params), static_cast<AST::Block*>((yyvsp[0].stmt))); delete (yyvsp[-4].str); ++g_resolveNodes; }
+#line 1365 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 24: /* funcdef: KW_DOUBLE IDENT '(' params ')' block  */
+#line 115 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+        { (yyval.stmt) = new AST::Function(AST::Type::Double, *(yyvsp[-4].str), (yyvsp[-2].params), static_cast<AST::Block*>((yyvsp[0].stmt))); delete (yyvsp[-4].str); ++g_resolveNodes; }
+#line 1371 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 25: /* params: %empty  */
+#line 119 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.params) = new std::vector<std::pair<AST::Type, std::string>>(); }
+#line 1377 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 26: /* params: paramlist  */
+#line 120 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.params) = (yyvsp[0].params); }
+#line 1383 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 27: /* paramlist: KW_INT IDENT  */
+#line 124 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.params) = new std::vector<std::pair<AST::Type, std::string>>(); (yyval.params)->emplace_back(AST::Type::Int, *(yyvsp[0].str)); delete (yyvsp[0].str); }
+#line 1389 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 28: /* paramlist: KW_DOUBLE IDENT  */
+#line 125 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.params) = new std::vector<std::pair<AST::Type, std::string>>(); (yyval.params)->emplace_back(AST::Type::Double, *(yyvsp[0].str)); delete (yyvsp[0].str); }
+#line 1395 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 29: /* paramlist: paramlist ',' KW_INT IDENT  */
+#line 126 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                                    { (yyvsp[-3].params)->emplace_back(AST::Type::Int, *(yyvsp[0].str)); delete (yyvsp[0].str); (yyval.params) = (yyvsp[-3].params); }
+#line 1401 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 30: /* paramlist: paramlist ',' KW_DOUBLE IDENT  */
+#line 127 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                                    { (yyvsp[-3].params)->emplace_back(AST::Type::Double, *(yyvsp[0].str)); delete (yyvsp[0].str); (yyval.params) = (yyvsp[-3].params); }
+#line 1407 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 31: /* return: KW_RETURN expr ';'  */
+#line 131 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.stmt) = new AST::Return((yyvsp[-1].expr)); ++g_resolveNodes; }
+#line 1413 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 32: /* return: KW_RETURN ';'  */
+#line 132 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.stmt) = new AST::Return(nullptr); ++g_resolveNodes; }
+#line 1419 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 33: /* call: IDENT '(' args ')'  */
+#line 136 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.expr) = new AST::Call(*(yyvsp[-3].str), (yyvsp[-1].args)); delete (yyvsp[-3].str); ++g_resolveNodes; }
+#line 1425 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 34: /* args: %empty  */
+#line 140 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.args) = new std::vector<AST::Expr*>(); }
+#line 1431 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 35: /* args: arglist  */
+#line 141 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.args) = (yyvsp[0].args); }
+#line 1437 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 36: /* arglist: expr  */
+#line 145 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.args) = new std::vector<AST::Expr*>(1, (yyvsp[0].expr)); }
+#line 1443 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 37: /* arglist: arglist ',' expr  */
+#line 146 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyvsp[-2].args)->push_back((yyvsp[0].expr)); (yyval.args) = (yyvsp[-2].args); }
+#line 1449 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 38: /* assign: IDENT '=' expr  */
+#line 151 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = new AST::Assign(*(yyvsp[-2].str), (yyvsp[0].expr)); delete (yyvsp[-2].str); }
-#line 1257 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1455 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 17: /* print: KW_PRINT '(' expr ')'  */
-#line 97 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 39: /* assign: IDENT '[' expr ']' '=' expr  */
+#line 152 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                                  { (yyval.stmt) = new AST::IndexAssign(*(yyvsp[-5].str), (yyvsp[-3].expr), (yyvsp[0].expr)); delete (yyvsp[-5].str); ++g_resolveNodes; }
+#line 1461 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 40: /* print: KW_PRINT '(' expr ')'  */
+#line 157 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.stmt) = new AST::Print((yyvsp[-1].expr)); }
-#line 1263 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1467 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 18: /* if: KW_IF '(' expr ')' stmt  */
-#line 103 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 41: /* if: KW_IF '(' expr ')' stmt  */
+#line 163 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
         { (yyval.stmt) = new AST::If((yyvsp[-2].expr), (yyvsp[0].stmt), nullptr); }
-#line 1269 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1473 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 19: /* if: KW_IF '(' expr ')' stmt KW_ELSE stmt  */
-#line 105 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 42: /* if: KW_IF '(' expr ')' stmt KW_ELSE stmt  */
+#line 165 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
         { (yyval.stmt) = new AST::If((yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt)); }
-#line 1275 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1479 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 20: /* while: KW_WHILE '(' expr ')' stmt  */
-#line 110 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 43: /* while: KW_WHILE '(' expr ')' stmt  */
+#line 170 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
         { (yyval.stmt) = new AST::While((yyvsp[-2].expr), (yyvsp[0].stmt)); }
-#line 1281 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1485 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 21: /* expr: expr '+' expr  */
-#line 115 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 44: /* expr: expr '+' expr  */
+#line 175 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Add, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1287 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1491 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 22: /* expr: expr '-' expr  */
-#line 116 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 45: /* expr: expr '-' expr  */
+#line 176 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Sub, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1293 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1497 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 23: /* expr: expr '*' expr  */
-#line 117 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 46: /* expr: expr '*' expr  */
+#line 177 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Mul, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1299 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1503 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 24: /* expr: expr '/' expr  */
-#line 118 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 47: /* expr: expr '/' expr  */
+#line 178 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Div, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1305 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1509 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 25: /* expr: expr '%' expr  */
-#line 119 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 48: /* expr: expr '%' expr  */
+#line 179 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Mod, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1311 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1515 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 26: /* expr: expr '<' expr  */
-#line 120 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 49: /* expr: expr '<' expr  */
+#line 180 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::LT,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1317 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1521 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 27: /* expr: expr LE expr  */
-#line 121 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 50: /* expr: expr LE expr  */
+#line 181 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::LE,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1323 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1527 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 28: /* expr: expr '>' expr  */
-#line 122 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 51: /* expr: expr '>' expr  */
+#line 182 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::GT,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1329 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1533 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 29: /* expr: expr GE expr  */
-#line 123 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 52: /* expr: expr GE expr  */
+#line 183 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::GE,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1335 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1539 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 30: /* expr: expr EQ expr  */
-#line 124 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 53: /* expr: expr EQ expr  */
+#line 184 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::EQ,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1341 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1545 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 31: /* expr: expr NE expr  */
-#line 125 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 54: /* expr: expr NE expr  */
+#line 185 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::NE,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1347 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1551 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 32: /* expr: expr AND expr  */
-#line 126 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 55: /* expr: expr AND expr  */
+#line 186 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::And, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1353 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1557 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 33: /* expr: expr OR expr  */
-#line 127 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 56: /* expr: expr OR expr  */
+#line 187 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Binary(AST::BinOp::Or,  (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1359 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1563 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 34: /* expr: '-' expr  */
-#line 128 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 57: /* expr: '-' expr  */
+#line 188 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Unary(AST::UnOp::Neg, (yyvsp[0].expr)); }
-#line 1365 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1569 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 35: /* expr: '!' expr  */
-#line 129 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 58: /* expr: '!' expr  */
+#line 189 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Unary(AST::UnOp::Not, (yyvsp[0].expr)); }
-#line 1371 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1575 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 36: /* expr: '(' expr ')'  */
-#line 130 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 59: /* expr: '(' expr ')'  */
+#line 190 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = (yyvsp[-1].expr); }
-#line 1377 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1581 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 37: /* expr: NUMBER  */
-#line 131 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 60: /* expr: NUMBER  */
+#line 191 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Number((yyvsp[0].num)); }
-#line 1383 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1587 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
-  case 38: /* expr: IDENT  */
-#line 132 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+  case 61: /* expr: IDENT  */
+#line 192 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
                              { (yyval.expr) = new AST::Ident(*(yyvsp[0].str)); delete (yyvsp[0].str); }
-#line 1389 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1593 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 62: /* expr: IDENT '[' expr ']'  */
+#line 193 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.expr) = new AST::Index(*(yyvsp[-3].str), (yyvsp[-1].expr)); delete (yyvsp[-3].str); ++g_resolveNodes; }
+#line 1599 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+    break;
+
+  case 63: /* expr: call  */
+#line 194 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+                             { (yyval.expr) = (yyvsp[0].expr); }
+#line 1605 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
     break;
 
 
-#line 1393 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
+#line 1609 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.cpp"
 
       default: break;
     }
@@ -1471,6 +1687,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1531,7 +1748,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -1539,24 +1756,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  goto yyreturn;
-#endif
+  goto yyreturnlab;
 
 
-/*-------------------------------------------------------.
-| yyreturn -- parsing is finished, clean up and return.  |
-`-------------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -1583,9 +1798,13 @@ yyreturn:
   return yyresult;
 }
 
-#line 135 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+#line 197 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+
 
+//     (--serve   볺); nullptr   stderr
+std::string* g_parseErrors = nullptr;
 
 void yyerror(const char* s) {
+    if (g_parseErrors) { *g_parseErrors += std::string("Parse error: ") + s + "\n"; return; }
     std::fprintf(stderr, "Parse error: %s\n", s);
 }
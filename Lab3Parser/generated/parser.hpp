@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.7.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -45,12 +45,14 @@
 extern int yydebug;
 #endif
 /* "%code requires" blocks.  */
-#line 18 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+#line 21 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
 
   #include <string>
+  #include <vector>
+  #include <utility>
   #include "../include/ast.hpp" /*     parser.hpp */
 
-#line 54 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.hpp"
+#line 56 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.hpp"
 
 /* Token kinds.  */
 #ifndef YYTOKENTYPE
@@ -67,16 +69,17 @@ extern int yydebug;
     KW_ELSE = 261,                 /* KW_ELSE  */
     KW_WHILE = 262,                /* KW_WHILE  */
     KW_PRINT = 263,                /* KW_PRINT  */
-    IDENT = 264,                   /* IDENT  */
-    NUMBER = 265,                  /* NUMBER  */
-    EQ = 266,                      /* EQ  */
-    NE = 267,                      /* NE  */
-    LE = 268,                      /* LE  */
-    GE = 269,                      /* GE  */
-    AND = 270,                     /* AND  */
-    OR = 271,                      /* OR  */
-    UMINUS = 272,                  /* UMINUS  */
-    LOWER_THAN_ELSE = 273          /* LOWER_THAN_ELSE  */
+    KW_RETURN = 264,               /* KW_RETURN  */
+    IDENT = 265,                   /* IDENT  */
+    NUMBER = 266,                  /* NUMBER  */
+    EQ = 267,                      /* EQ  */
+    NE = 268,                      /* NE  */
+    LE = 269,                      /* LE  */
+    GE = 270,                      /* GE  */
+    AND = 271,                     /* AND  */
+    OR = 272,                      /* OR  */
+    UMINUS = 273,                  /* UMINUS  */
+    LOWER_THAN_ELSE = 274          /* LOWER_THAN_ELSE  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -85,16 +88,18 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 24 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
+#line 29 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\src\\parser.y"
 
     double num;
     std::string* str;
     AST::Expr* expr;
     AST::Stmt* stmt;
     AST::Block* block;
+    std::vector<AST::Expr*>* args;
+    std::vector<std::pair<AST::Type, std::string>>* params;
     int token;
 
-#line 98 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.hpp"
+#line 103 "D:\\Study\\University\\System_programming\\Lab3Parser\\Lab3Parser\\generated\\parser.hpp"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -105,6 +110,8 @@ typedef union YYSTYPE YYSTYPE;
 
 extern YYSTYPE yylval;
 
+
 int yyparse (void);
 
+
 #endif /* !YY_YY_D_STUDY_UNIVERSITY_SYSTEM_PROGRAMMING_LAB3PARSER_LAB3PARSER_GENERATED_PARSER_HPP_INCLUDED  */
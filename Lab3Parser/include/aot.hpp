@@ -0,0 +1,231 @@
+// include/aot.hpp
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <filesystem>
+#include <system_error>
+#include "tac.hpp"
+#include "regalloc.hpp"
+#include "astcache.hpp"
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace AOT {
+
+    //    : 0  , 1    , 2 + k     k
+    using PrintFn = void (*)(void* io, double v);
+    using EntryFn = int (*)(void* io, PrintFn print);
+
+    //    C,     
+    inline void literal(std::string& s, double v) {
+        if (std::isnan(v)) { s += "NAN"; return; }
+        if (std::isinf(v)) { s += v < 0 ? "-HUGE_VAL" : "HUGE_VAL"; return; }
+        char tmp[40];
+        int n = std::snprintf(tmp, sizeof tmp, "%.17g", v);
+        s.append(tmp, static_cast<std::size_t>(n));
+        bool integral = true;
+        for (int i = 0; i < n; ++i) if (tmp[i] == '.' || tmp[i] == 'e') integral = false;
+        if (integral) s += ".0"; //  1 / 2   
+    }
+
+    //   C:   tN   double,    goto,
+    //   static (    ),   ,   VM
+    inline std::string emitC(const TAC::Unit& u) {
+        using TAC::Op;
+        using TAC::Operand;
+        std::string s;
+        s.reserve(u.code.size() * 32 + 256);
+        s += "/* generated by Lab3Parser --aot */\n#include <math.h>\n#include <string.h>\n\n";
+        for (std::size_t i = 0; i < u.arrays.size(); ++i)
+            s += "static double a" + std::to_string(i) + "[" + std::to_string(u.arrays[i].size) + "]; /* " + u.arrays[i].name + " */\n";
+        if (!u.arrays.empty()) s += '\n';
+        s += "int lab3_main(void* io, void (*print)(void*, double)) {\n";
+        for (std::size_t i = 0; i < u.arrays.size(); ++i)
+            s += "    memset(a" + std::to_string(i) + ", 0, sizeof a" + std::to_string(i) + ");\n";
+        for (std::size_t i = 0; i < u.vars.size(); ++i)
+            s += "    double v" + std::to_string(i) + " = 0.0; /* " + u.vars[i] + " */\n";
+        for (std::uint32_t t = 1; t <= u.temps; ++t)
+            s += "    double t" + std::to_string(t) + " = 0.0;\n";
+
+        auto operand = [&](const Operand& o) {
+            switch (o.kind) {
+            case Operand::Kind::Var: s += 'v'; s += std::to_string(o.index); break;
+            case Operand::Kind::Temp: s += 't'; s += std::to_string(o.index); break;
+            case Operand::Kind::Const: literal(s, u.consts[o.index]); break;
+            default: s += "0.0"; break;
+            }
+        };
+        auto rel = [&](const TAC::Instr& in) {
+            s += '('; operand(in.a); s += ' '; s += TAC::relText(in.rel); s += ' '; operand(in.b); s += ')';
+        };
+        auto jump = [&](std::uint32_t l) { s += " goto L"; s += std::to_string(l); s += ";\n"; };
+        // :   (   ),   a3[(long)i]
+        auto check = [&](const TAC::Instr& in) {
+            if (in.unchecked) return;
+            s += "if (!("; operand(in.a); s += " >= 0.0 && "; operand(in.a);
+            s += " < " + std::to_string(u.arrays[in.label].size) + ".0)) return " + std::to_string(in.label + 2) + "; ";
+        };
+        auto cell = [&](const TAC::Instr& in) { s += 'a'; s += std::to_string(in.label); s += "[(long)"; operand(in.a); s += ']'; };
+
+        for (auto& in : u.code) {
+            if (in.op == Op::Label) { s += 'L'; s += std::to_string(in.label); s += ":;\n"; continue; }
+            s += "    ";
+            switch (in.op) {
+            case Op::Copy: operand(in.dst); s += " = "; operand(in.a); s += ";\n"; break;
+            case Op::Neg: operand(in.dst); s += " = -"; operand(in.a); s += ";\n"; break;
+            case Op::Add: case Op::Sub: case Op::Mul:
+                operand(in.dst); s += " = "; operand(in.a);
+                s += ' '; s += TAC::opText(in.op); s += ' '; operand(in.b); s += ";\n";
+                break;
+            case Op::Div:
+                s += "if ("; operand(in.b); s += " == 0.0) return 1; ";
+                operand(in.dst); s += " = "; operand(in.a); s += " / "; operand(in.b); s += ";\n";
+                break;
+            case Op::Mod:
+                operand(in.dst); s += " = fmod("; operand(in.a); s += ", "; operand(in.b); s += ");\n";
+                break;
+            case Op::IfRel: s += "if "; rel(in); jump(in.label); break;
+            case Op::IfFalseRel: s += "if (!"; rel(in); s += ')'; jump(in.label); break;
+            case Op::If: s += "if ("; operand(in.a); s += " != 0.0)"; jump(in.label); break;
+            case Op::IfFalse: s += "if ("; operand(in.a); s += " == 0.0)"; jump(in.label); break;
+            case Op::Goto: s += "goto L"; s += std::to_string(in.label); s += ";\n"; break;
+            case Op::Print: s += "print(io, "; operand(in.a); s += ");\n"; break;
+            case Op::Load: check(in); operand(in.dst); s += " = "; cell(in); s += ";\n"; break;
+            case Op::Store: check(in); cell(in); s += " = "; operand(in.b); s += ";\n"; break;
+            case Op::Array: s += "memset(a" + std::to_string(in.label) + ", 0, sizeof a" + std::to_string(in.label) + ");\n"; break;
+            default: break;
+            }
+        }
+        s += "    return 0;\n}\n";
+        return s;
+    }
+
+    //  .so;    '
+    struct Module {
+        void* handle = nullptr;
+        EntryFn entry = nullptr;
+        std::vector<std::string> arrays; //   "index out of range"
+
+        Module() = default;
+        Module(const Module&) = delete;
+        Module& operator=(const Module&) = delete;
+        Module(Module&& o) noexcept : handle(o.handle), entry(o.entry), arrays(std::move(o.arrays)) { o.handle = nullptr; o.entry = nullptr; }
+        Module& operator=(Module&& o) noexcept {
+            std::swap(handle, o.handle);
+            std::swap(entry, o.entry);
+            std::swap(arrays, o.arrays);
+            return *this;
+        }
+        ~Module() {
+#ifndef _WIN32
+            if (handle) ::dlclose(handle);
+#endif
+        }
+
+        //    AST::Print,     ,    
+        void run(std::ostream& out, IO::Digits digits = IO::Digits::Twelve) const {
+            struct Io {
+                std::ostream* out;
+                IO::Digits digits;
+            } io{ &out, digits };
+            auto print = [](void* p, double v) {
+                auto& t = *static_cast<Io*>(p);
+                char tmp[IO::numberChars + 1];
+                std::size_t n = IO::formatNumber(tmp, v, t.digits);
+                tmp[n++] = '\n';
+                t.out->write(tmp, static_cast<std::streamsize>(n));
+            };
+            int rc = entry(&io, print);
+            if (rc == 1) throw std::runtime_error("division by zero");
+            if (rc >= 2) throw std::runtime_error("index out of range: " + arrays.at(static_cast<std::size_t>(rc - 2)));
+        }
+    };
+
+    //  C   (CC  cc)    AST;
+    //        
+    struct Builder {
+        std::filesystem::path dir;
+        bool hit = false;
+
+        //  emitC  쳺:    ,   build
+        static bool supports(const TAC::Unit& u) { return u.functions.empty(); }
+
+        Module build(TAC::Unit u) {
+#ifdef _WIN32
+            (void)u;
+            throw std::runtime_error("native compilation is not supported on this platform");
+#else
+            if (!u.functions.empty()) throw std::runtime_error("functions are not supported by --aot");
+            //   tN   ,   cc
+            TAC::TempAllocator(u, 0).run();
+            const char* env = std::getenv("CC");
+            std::string cc = env && *env ? env : "cc";
+            std::string flags = " -O2 -shared -fPIC";
+            std::string src = emitC(u);
+            std::string keyText = cc + flags + '\n' + src;
+            auto key = ASTCache::hashBytes(keyText.data(), keyText.size());
+
+            char name[32];
+            std::snprintf(name, sizeof name, "%016llx", static_cast<unsigned long long>(key));
+            auto so = dir / (std::string(name) + ".so");
+
+            std::error_code ec;
+            hit = std::filesystem::exists(so, ec);
+            if (hit) std::filesystem::last_write_time(so, std::filesystem::file_time_type::clock::now(), ec);
+            else compile(cc + flags, src, so);
+
+            Module m;
+            m.handle = ::dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!m.handle) throw std::runtime_error(std::string("dlopen: ") + ::dlerror());
+            m.entry = reinterpret_cast<EntryFn>(::dlsym(m.handle, "lab3_main"));
+            if (!m.entry) throw std::runtime_error("lab3_main not found in " + so.string());
+            for (auto& a : u.arrays) m.arrays.push_back(a.name);
+            return m;
+#endif
+        }
+
+#ifndef _WIN32
+    private:
+        static std::string quote(const std::string& s) {
+            std::string q = "'";
+            for (char c : s) { if (c == '\'') q += "'\\''"; else q += c; }
+            return q + "'";
+        }
+
+        void compile(const std::string& cmd, const std::string& src, const std::filesystem::path& so) const {
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            //       :       
+            auto tag = ASTCache::tmpTag();
+            auto c = so; c += tag + ".c";
+            auto tmp = so; tmp += tag + ".tmp";
+            {
+                FILE* f = std::fopen(c.c_str(), "wb");
+                if (!f) throw std::runtime_error("cannot write " + c.string());
+                bool ok = std::fwrite(src.data(), 1, src.size(), f) == src.size();
+                ok = std::fclose(f) == 0 && ok;
+                if (!ok) { std::filesystem::remove(c, ec); throw std::runtime_error("cannot write " + c.string()); }
+            }
+            std::string line = cmd + " -o " + quote(tmp.string()) + " " + quote(c.string()) + " -lm";
+            int rc = std::system(line.c_str());
+            std::filesystem::remove(c, ec);
+            if (rc != 0) {
+                std::filesystem::remove(tmp, ec);
+                throw std::runtime_error("C compiler failed: " + line);
+            }
+            std::filesystem::rename(tmp, so, ec); //    
+            if (ec) throw std::runtime_error("cannot store " + so.string());
+        }
+#endif
+    };
+
+} // namespace AOT
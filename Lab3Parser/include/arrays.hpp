@@ -0,0 +1,248 @@
+// include/arrays.hpp
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include "ast.hpp"
+
+namespace AST {
+
+    //  ' : a[i]   ArrayDecl,     
+    //   ;        ( ).
+    //          ,      
+    //     .       (bounds).
+    class Arrays {
+    public:
+        std::uint32_t count = 0;    // ArrayDecl  
+        std::size_t unchecked = 0;  //   
+
+        void run(Block& root) {
+            count = 0;
+            unchecked = 0;
+            globals.clear();
+            for (auto& s : root.items)
+                if (auto d = dynamic_cast<ArrayDecl*>(s.get())) globals.emplace(d->name, d);
+            scopes.assign(1, Scope());
+            items(root);
+        }
+
+    private:
+        using Scope = std::unordered_map<std::string, const ArrayDecl*>;
+
+        Scope globals;
+        std::vector<Scope> scopes;
+        bool inFunction = false;
+
+        const ArrayDecl* lookup(const std::string& name) const {
+            if (inFunction) {
+                auto f = globals.find(name);
+                if (f != globals.end()) return f->second;
+            }
+            else
+                for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+                    auto f = it->find(name);
+                    if (f != it->end()) return f->second;
+                }
+            throw std::runtime_error("undefined array: " + name);
+        }
+
+        void expr(Expr* e) {
+            if (auto ix = dynamic_cast<Index*>(e)) { ix->decl = lookup(ix->name); expr(ix->index.get()); }
+            else if (auto u = dynamic_cast<Unary*>(e)) expr(u->E.get());
+            else if (auto b = dynamic_cast<Binary*>(e)) { expr(b->L.get()); expr(b->R.get()); }
+            else if (auto c = dynamic_cast<Call*>(e)) for (auto& a : c->args) expr(a.get());
+        }
+
+        void items(Block& b) {
+            for (std::size_t i = 0; i < b.items.size(); ++i) {
+                Stmt* s = b.items[i].get();
+                if (auto d = dynamic_cast<ArrayDecl*>(s)) {
+                    if (inFunction) throw std::runtime_error("arrays are not supported inside functions: " + d->name);
+                    if (!d->size) throw std::runtime_error("bad array size: " + d->name);
+                    if (!scopes.back().emplace(d->name, d).second) throw std::runtime_error("redeclaration in the same scope: " + d->name);
+                    d->id = count++;
+                    continue;
+                }
+                stmt(s);
+                if (auto w = dynamic_cast<While*>(s))
+                    if (!inFunction) bounds(*w, b, i);
+            }
+        }
+
+        void stmt(Stmt* s) {
+            if (auto b = dynamic_cast<Block*>(s)) {
+                scopes.emplace_back();
+                items(*b);
+                scopes.pop_back();
+            }
+            else if (auto d = dynamic_cast<ArrayDecl*>(s)) throw std::runtime_error("array declaration outside a block: " + d->name);
+            else if (auto vd = dynamic_cast<VarDecl*>(s)) { if (vd->init) expr(vd->init.get()); }
+            else if (auto a = dynamic_cast<Assign*>(s)) expr(a->value.get());
+            else if (auto ia = dynamic_cast<IndexAssign*>(s)) {
+                ia->decl = lookup(ia->name);
+                expr(ia->index.get());
+                expr(ia->value.get());
+            }
+            else if (auto p = dynamic_cast<Print*>(s)) expr(p->what.get());
+            else if (auto i = dynamic_cast<If*>(s)) {
+                expr(i->cond.get());
+                stmt(i->thenS.get());
+                if (i->elseS) stmt(i->elseS.get());
+            }
+            else if (auto w = dynamic_cast<While*>(s)) { expr(w->cond.get()); stmt(w->body.get()); }
+            else if (auto r = dynamic_cast<Return*>(s)) { if (r->value) expr(r->value.get()); }
+            else if (auto x = dynamic_cast<ExprStmt*>(s)) expr(x->expr.get());
+            else if (auto f = dynamic_cast<Function*>(s)) {
+                inFunction = true;
+                stmt(f->body.get());
+                inFunction = false;
+            }
+        }
+
+        // ----------  ----------
+        //  "i = lo; while (i < c) { ...; i = i + k; ... }"   lo >= 0, k >= 0, c:
+        // i  ,     lo <= i,       i < c (i <= c).
+        //   i,  i     .  a[i + d]  ,
+        //  lo + d >= 0  c + d <= size (c + d < size  <=). ֳ   i + d  .
+        struct Range {
+            const std::string* name;
+            double lo, c;
+            bool strict;
+        };
+
+        static bool integral(double v) { return std::fabs(v) < 2147483648.0 && v == std::floor(v); }
+
+        static bool isVar(const Expr* e, const std::string& name) {
+            auto id = dynamic_cast<const Ident*>(e);
+            return id && id->ref == Ref::Scoped && id->name == name;
+        }
+
+        static bool constant(const Expr* e, double& v) {
+            auto n = dynamic_cast<const Number*>(e);
+            if (!n || !integral(n->value)) return false;
+            v = n->value;
+            return true;
+        }
+
+        // i = i + k / i = k + i
+        static bool isStep(const Stmt* s, const std::string& name) {
+            auto a = dynamic_cast<const Assign*>(s);
+            if (!a || a->ref != Ref::Scoped || a->name != name) return false;
+            auto b = dynamic_cast<const Binary*>(a->value.get());
+            double k;
+            if (!b || b->op != BinOp::Add) return false;
+            return ((isVar(b->L.get(), name) && constant(b->R.get(), k)) ||
+                (isVar(b->R.get(), name) && constant(b->L.get(), k))) && k >= 0.0;
+        }
+
+        //   /  i: ,  (), 
+        static bool touches(const Expr* e, const std::string& name) {
+            if (dynamic_cast<const Call*>(e)) return true;
+            if (auto ix = dynamic_cast<const Index*>(e)) return touches(ix->index.get(), name);
+            if (auto u = dynamic_cast<const Unary*>(e)) return touches(u->E.get(), name);
+            if (auto b = dynamic_cast<const Binary*>(e)) return touches(b->L.get(), name) || touches(b->R.get(), name);
+            return false;
+        }
+        static bool touches(const Stmt* s, const std::string& name) {
+            if (!s) return false;
+            if (auto b = dynamic_cast<const Block*>(s)) {
+                for (auto& i : b->items) if (touches(i.get(), name)) return true;
+                return false;
+            }
+            if (auto vd = dynamic_cast<const VarDecl*>(s)) return vd->name == name || (vd->init && touches(vd->init.get(), name));
+            if (auto a = dynamic_cast<const Assign*>(s)) return a->name == name || touches(a->value.get(), name);
+            if (auto ia = dynamic_cast<const IndexAssign*>(s)) return touches(ia->index.get(), name) || touches(ia->value.get(), name);
+            if (auto p = dynamic_cast<const Print*>(s)) return touches(p->what.get(), name);
+            if (auto i = dynamic_cast<const If*>(s))
+                return touches(i->cond.get(), name) || touches(i->thenS.get(), name) || touches(i->elseS.get(), name);
+            if (auto w = dynamic_cast<const While*>(s)) return touches(w->cond.get(), name) || touches(w->body.get(), name);
+            if (auto x = dynamic_cast<const ExprStmt*>(s)) return touches(x->expr.get(), name);
+            return !dynamic_cast<const ArrayDecl*>(s);
+        }
+
+        void bounds(While& w, const Block& parent, std::size_t at) {
+            auto cmp = dynamic_cast<const Binary*>(w.cond.get());
+            if (!cmp || (cmp->op != BinOp::LT && cmp->op != BinOp::LE)) return;
+            auto iv = dynamic_cast<const Ident*>(cmp->L.get());
+            Range r;
+            if (!iv || iv->ref != Ref::Scoped || !constant(cmp->R.get(), r.c)) return;
+            r.name = &iv->name;
+            r.strict = cmp->op == BinOp::LT;
+
+            //      int i = lo; / i = lo;   i   
+            const Stmt* before = nullptr;
+            while (at-- > 0) {
+                before = parent.items[at].get();
+                if (touches(before, iv->name)) break;
+                before = nullptr;
+            }
+            const Expr* init = nullptr;
+            if (auto vd = dynamic_cast<const VarDecl*>(before)) {
+                if (vd->ref != Ref::Scoped || vd->name != iv->name) return;
+                if (!vd->init) r.lo = 0.0;
+                else init = vd->init.get();
+            }
+            else if (auto a = dynamic_cast<const Assign*>(before)) {
+                if (a->ref != Ref::Scoped || a->name != iv->name) return;
+                init = a->value.get();
+            }
+            else return;
+            if (init && !constant(init, r.lo)) return;
+            if (r.lo < 0.0) return;
+
+            std::vector<Stmt*> body;
+            if (auto b = dynamic_cast<Block*>(w.body.get())) for (auto& i : b->items) body.push_back(i.get());
+            else body.push_back(w.body.get());
+            std::size_t first = body.size();
+            for (std::size_t k = 0; k < body.size(); ++k) {
+                if (isStep(body[k], iv->name)) { if (first == body.size()) first = k; }
+                else if (touches(body[k], iv->name)) return;
+            }
+            for (std::size_t k = 0; k < first; ++k) mark(body[k], r);
+        }
+
+        bool inRange(const Expr* index, const ArrayDecl* d, const Range& r) {
+            double off = 0.0;
+            if (!isVar(index, *r.name)) {
+                auto b = dynamic_cast<const Binary*>(index);
+                if (!b || (b->op != BinOp::Add && b->op != BinOp::Sub)) return false;
+                if (isVar(b->L.get(), *r.name) && constant(b->R.get(), off)) { if (b->op == BinOp::Sub) off = -off; }
+                else if (!(b->op == BinOp::Add && isVar(b->R.get(), *r.name) && constant(b->L.get(), off))) return false;
+            }
+            double top = r.c + off, size = d->size;
+            return r.lo + off >= 0.0 && (r.strict ? top <= size : top < size);
+        }
+
+        void mark(Expr* e, const Range& r) {
+            if (auto ix = dynamic_cast<Index*>(e)) {
+                if (ix->checked && inRange(ix->index.get(), ix->decl, r)) { ix->checked = false; ++unchecked; }
+                mark(ix->index.get(), r);
+            }
+            else if (auto u = dynamic_cast<Unary*>(e)) mark(u->E.get(), r);
+            else if (auto b = dynamic_cast<Binary*>(e)) { mark(b->L.get(), r); mark(b->R.get(), r); }
+        }
+
+        void mark(Stmt* s, const Range& r) {
+            if (auto b = dynamic_cast<Block*>(s)) { for (auto& i : b->items) mark(i.get(), r); }
+            else if (auto vd = dynamic_cast<VarDecl*>(s)) { if (vd->init) mark(vd->init.get(), r); }
+            else if (auto a = dynamic_cast<Assign*>(s)) mark(a->value.get(), r);
+            else if (auto ia = dynamic_cast<IndexAssign*>(s)) {
+                if (ia->checked && inRange(ia->index.get(), ia->decl, r)) { ia->checked = false; ++unchecked; }
+                mark(ia->index.get(), r);
+                mark(ia->value.get(), r);
+            }
+            else if (auto p = dynamic_cast<Print*>(s)) mark(p->what.get(), r);
+            else if (auto i = dynamic_cast<If*>(s)) {
+                mark(i->cond.get(), r);
+                mark(i->thenS.get(), r);
+                if (i->elseS) mark(i->elseS.get(), r);
+            }
+            else if (auto w = dynamic_cast<While*>(s)) { mark(w->cond.get(), r); mark(w->body.get(), r); }
+            else if (auto x = dynamic_cast<ExprStmt*>(s)) mark(x->expr.get(), r);
+        }
+    };
+
+} // namespace AST
@@ -10,13 +10,58 @@
 #include <iomanip>
 #include <cmath> 
 #include <utility>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include "writer.hpp"
+#include "trace.hpp"
+
+// ҳ      :   evalT/execT 
+//  ,   Context      
+#if defined(_MSC_VER)
+#define AST_BODY __forceinline
+#else
+#define AST_BODY inline __attribute__((always_inline))
+#endif
 
 namespace AST {
 
-    struct Context {
+    //    ( ,  VM):    ,   
+    // . г   150-250   (  ),  2500   1 
+    constexpr std::uint32_t maxCallDepth = 2500;
+
+    //    , ;   
+    constexpr std::size_t framePool = 1024;
+
+    //  ,  (128  double)
+    constexpr std::uint32_t maxArray = 1u << 24;
+
+    // Policy    (trace.hpp):    get/assign/declare  
+    template<class Policy>
+    struct BasicContext : Policy {
         std::vector<std::unordered_map<std::string, double>> scopes;
+        std::ostream* out = &std::cout; //   Print (--batch:  )
+        std::uint64_t maxSteps = 0;     //   , 0   
+        std::uint64_t steps = 0;
+        const std::atomic<bool>* cancel = nullptr; //  :  
+        IO::Digits digits = IO::Digits::Twelve;    //  Print  
+
+        // :    frames  frame,       (funcs.hpp)
+        std::vector<double> frames;
+        std::size_t frame = 0, top = 0; //      
+        std::uint32_t depth = 0;
+        bool returning = false;         //  return: Block  While 
+        double result = 0.0;
+
+        // :     ArrayDecl ,    (arrays.hpp)
+        std::vector<std::vector<double>> arrays;
+
+        void step() {
+            if (maxSteps && ++steps > maxSteps) throw std::runtime_error("step limit exceeded");
+            if (cancel && cancel->load(std::memory_order_relaxed)) throw std::runtime_error("cancelled");
+        }
 
-        Context() { push(); } //   
+        BasicContext() { push(); } //   
 
         void push() { scopes.emplace_back(); }
         void pop() {
@@ -29,6 +74,7 @@ namespace AST {
             auto& cur = scopes.back();
             if (cur.count(name)) return false; //     
             cur[name] = value;
+            this->Policy::declare(name, value);
             return true;
         }
 
@@ -36,48 +82,128 @@ namespace AST {
         bool assign(const std::string& name, double value) {
             for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
                 auto f = it->find(name);
-                if (f != it->end()) { f->second = value; return true; }
+                if (f != it->end()) { f->second = value; this->Policy::write(name, value); return true; }
             }
             return false;
         }
 
         //     
-        double get(const std::string& name) const {
+        double get(const std::string& name) {
             for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
                 auto f = it->find(name);
-                if (f != it->end()) return f->second;
+                if (f != it->end()) { this->Policy::read(name, f->second); return f->second; }
             }
             throw std::runtime_error("undefined variable: " + name);
         }
+
+        //   slots   ;   
+        std::size_t reserve(std::uint32_t slots) {
+            std::size_t base = top;
+            top += slots;
+            if (frames.size() < top) frames.resize(std::max(top, std::max(framePool, frames.size() * 2)));
+            return base;
+        }
+
+        double local(std::uint32_t slot, const std::string& name) {
+            double v = frames[frame + slot];
+            this->Policy::read(name, v);
+            return v;
+        }
+        void setLocal(std::uint32_t slot, const std::string& name, double value) {
+            frames[frame + slot] = value;
+            this->Policy::write(name, value);
+        }
+        void declareLocal(std::uint32_t slot, const std::string& name, double value) {
+            frames[frame + slot] = value;
+            this->Policy::declare(name, value);
+        }
+
+        //    :   ,    
+        double global(const std::string& name) {
+            auto f = scopes.front().find(name);
+            if (f == scopes.front().end()) throw std::runtime_error("undefined variable: " + name);
+            this->Policy::read(name, f->second);
+            return f->second;
+        }
+        bool assignGlobal(const std::string& name, double value) {
+            auto f = scopes.front().find(name);
+            if (f == scopes.front().end()) return false;
+            f->second = value;
+            this->Policy::write(name, value);
+            return true;
+        }
+
+        //        
+        void declareArray(std::uint32_t id, const std::string& name, std::uint32_t size) {
+            if (arrays.size() <= id) arrays.resize(id + 1);
+            arrays[id].assign(size, 0.0);
+            this->Policy::declare(name, 0.0);
+        }
+
+        //    ;   ,  (int)
+        std::size_t at(std::uint32_t id, const std::string& name, double i) const {
+            if (id >= arrays.size() || arrays[id].empty()) throw std::runtime_error("undefined variable: " + name);
+            if (!(i >= 0.0 && i < static_cast<double>(arrays[id].size()))) throw std::runtime_error("index out of range: " + name);
+            return static_cast<std::size_t>(i);
+        }
+
+        double load(std::uint32_t id, const std::string& name, std::size_t k) {
+            double v = arrays[id][k];
+            this->Policy::read(name, v);
+            return v;
+        }
+        void store(std::uint32_t id, const std::string& name, std::size_t k, double value) {
+            arrays[id][k] = value;
+            this->Policy::write(name, value);
+        }
     };
 
+    using Context = BasicContext<Trace::NoTrace>;
+    using TraceContext = BasicContext<Trace::Recorder>;
+
     struct Node {
         virtual ~Node() = default;
-        virtual void emitDOT(std::ostream& out, int& id, int parent = -1) const = 0;
+        virtual void emitDOT(IO::Writer& out, int& id, int parent = -1) const = 0;
     };
 
+    //      ;    (evalT/execT),
+    //   NoTrace    ,    
     struct Expr : Node {
         virtual double eval(Context& ctx) const = 0;
+        virtual double eval(TraceContext& ctx) const = 0;
     };
 
-    struct Number : Expr {
+    template<class D>
+    struct ExprImpl : Expr {
+        double eval(Context& ctx) const override { return static_cast<const D*>(this)->evalT(ctx); }
+        double eval(TraceContext& ctx) const override { return static_cast<const D*>(this)->evalT(ctx); }
+    };
+
+    struct Number : ExprImpl<Number> {
         double value;
         explicit Number(double v) : value(v) {}
-        double eval(Context&) const override { return value; }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        template<class C> AST_BODY double evalT(C&) const { return value; }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
-            out << "  n" << me << " [label=\"Number(" << std::setprecision(12) << value << ")\"];\n";
+            out << "  n" << me << " [label=\"Number(" << value << ")\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
         }
     };
 
-    struct Ident : Expr {
+    //   : Scoped     , Local    ,
+    // Global    (  ).  AST::resolve
+    enum class Ref : std::uint8_t { Scoped, Local, Global };
+
+    struct Ident : ExprImpl<Ident> {
         std::string name;
+        Ref ref = Ref::Scoped;
+        std::uint32_t slot = 0;
         explicit Ident(std::string n) : name(std::move(n)) {}
-        double eval(Context& ctx) const override {
-            return ctx.get(name);
+        template<class C> AST_BODY double evalT(C& ctx) const {
+            if (ref == Ref::Scoped) return ctx.get(name);
+            return ref == Ref::Local ? ctx.local(slot, name) : ctx.global(name);
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"Ident(" << name << ")\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -90,7 +216,7 @@ namespace AST {
         And, Or
     };
 
-    struct Binary : Expr {
+    struct Binary : ExprImpl<Binary> {
         BinOp op;
         std::unique_ptr<Expr> L, R;
 
@@ -102,7 +228,7 @@ namespace AST {
             : op(o), L(std::move(l)), R(std::move(r)) {
         }
         static double toBool(double x) { return x != 0.0 ? 1.0 : 0.0; }
-        double eval(Context& ctx) const override {
+        template<class C> AST_BODY double evalT(C& ctx) const {
             if (op == BinOp::And) {
                 return toBool(L->eval(ctx)) && toBool(R->eval(ctx)) ? 1.0 : 0.0;
             }
@@ -125,7 +251,7 @@ namespace AST {
             default:         return 0.0;
             }
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             auto label = [this]() {
                 switch (op) {
                 case BinOp::Add: return "+";
@@ -154,7 +280,7 @@ namespace AST {
 
     enum class UnOp { Neg, Not };
 
-    struct Unary : Expr {
+    struct Unary : ExprImpl<Unary> {
         UnOp op;
         std::unique_ptr<Expr> E;
 
@@ -163,11 +289,11 @@ namespace AST {
 
         //   ():
         Unary(UnOp o, std::unique_ptr<Expr> e) : op(o), E(std::move(e)) {}
-        double eval(Context& ctx) const override {
+        template<class C> AST_BODY double evalT(C& ctx) const {
             double v = E->eval(ctx);
             return op == UnOp::Neg ? -v : (v == 0.0 ? 1.0 : 0.0);
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             const char* label = (op == UnOp::Neg) ? "unary -" : "!";
             int me = id++;
             out << "  n" << me << " [label=\"Unary(" << label << ")\"];\n";
@@ -178,9 +304,20 @@ namespace AST {
 
     struct Stmt : Node {
         virtual void exec(Context& ctx) const = 0;
+        virtual void exec(TraceContext& ctx) const = 0;
+    };
+
+    // Enter/Exit    , Exit    (Trace::Scope)
+    template<class D>
+    struct StmtImpl : Stmt {
+        void exec(Context& ctx) const override { static_cast<const D*>(this)->execT(ctx); }
+        void exec(TraceContext& ctx) const override {
+            Trace::Scope<TraceContext> span(ctx, *this);
+            static_cast<const D*>(this)->execT(ctx);
+        }
     };
 
-    struct Block : Stmt {
+    struct Block : StmtImpl<Block> {
         std::vector<std::unique_ptr<Stmt>> items;
         bool createScope = false; // < 
 
@@ -190,13 +327,16 @@ namespace AST {
         void setScoped(bool v) { createScope = v; } // < 
         void add(Stmt* s) { items.emplace_back(s); }
 
-        void exec(Context& ctx) const override {
+        template<class C> AST_BODY void execT(C& ctx) const {
             if (createScope) ctx.push();     // < :   
-            for (auto& s : items) s->exec(ctx);
+            for (auto& s : items) {
+                s->exec(ctx);
+                if (ctx.returning) break;
+            }
             if (createScope) ctx.pop();      // < :   
         }
 
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"Block\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -206,18 +346,21 @@ namespace AST {
 
     enum class Type { Int, Double };
 
-    struct VarDecl : Stmt {
+    struct VarDecl : StmtImpl<VarDecl> {
         Type type;
         std::string name;
         std::unique_ptr<Expr> init;
+        Ref ref = Ref::Scoped;
+        std::uint32_t slot = 0;
         VarDecl(Type t, std::string n, Expr* e = nullptr) : type(t), name(std::move(n)), init(e) {}
-        void exec(Context& ctx) const override {
+        template<class C> AST_BODY void execT(C& ctx) const {
             double v = init ? init->eval(ctx) : 0.0;
+            if (ref == Ref::Local) { ctx.declareLocal(slot, name, v); return; }
             if (!ctx.declare(name, v)) {
                 throw std::runtime_error("redeclaration in the same scope: " + name);
             }
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"VarDecl(" << (type == Type::Int ? "int" : "double") << " " << name << ")\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -225,17 +368,20 @@ namespace AST {
         }
     };
 
-    struct Assign : Stmt {
+    struct Assign : StmtImpl<Assign> {
         std::string name;
         std::unique_ptr<Expr> value;
+        Ref ref = Ref::Scoped;
+        std::uint32_t slot = 0;
         Assign(std::string n, Expr* v) : name(std::move(n)), value(v) {}
-        void exec(Context& ctx) const override {
+        template<class C> AST_BODY void execT(C& ctx) const {
             double v = value->eval(ctx);
-            if (!ctx.assign(name, v)) {
+            if (ref == Ref::Local) { ctx.setLocal(slot, name, v); return; }
+            if (!(ref == Ref::Scoped ? ctx.assign(name, v) : ctx.assignGlobal(name, v))) {
                 throw std::runtime_error("assignment to undeclared variable: " + name);
             }
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"Assign(" << name << ")\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -243,15 +389,20 @@ namespace AST {
         }
     };
 
-    struct Print : Stmt {
+    struct Print : StmtImpl<Print> {
         std::unique_ptr<Expr> what;
         explicit Print(Expr* e) : what(e) {}
-        void exec(Context& ctx) const override {
+        template<class C> AST_BODY void execT(C& ctx) const {
             double v = what->eval(ctx);
-            //     :   ,  
-            std::cout << std::setprecision(12) << v << std::endl;
+            //     :   ,  ;
+            //        flush   
+            char tmp[IO::numberChars + 1];
+            std::size_t n = IO::formatNumber(tmp, v, ctx.digits);
+            tmp[n++] = '\n';
+            ctx.out->write(tmp, static_cast<std::streamsize>(n));
+            ctx.print(v);
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"Print\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -259,16 +410,16 @@ namespace AST {
         }
     };
 
-    struct If : Stmt {
+    struct If : StmtImpl<If> {
         std::unique_ptr<Expr> cond;
         std::unique_ptr<Stmt> thenS;
         std::unique_ptr<Stmt> elseS; // may be null
         If(Expr* c, Stmt* t, Stmt* e = nullptr) : cond(c), thenS(t), elseS(e) {}
-        void exec(Context& ctx) const override {
+        template<class C> AST_BODY void execT(C& ctx) const {
             if (cond->eval(ctx) != 0.0) thenS->exec(ctx);
             else if (elseS) elseS->exec(ctx);
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"If\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -278,14 +429,18 @@ namespace AST {
         }
     };
 
-    struct While : Stmt {
+    struct While : StmtImpl<While> {
         std::unique_ptr<Expr> cond;
         std::unique_ptr<Stmt> body;
         While(Expr* c, Stmt* b) : cond(c), body(b) {}
-        void exec(Context& ctx) const override {
-            while (cond->eval(ctx) != 0.0) body->exec(ctx);
+        template<class C> AST_BODY void execT(C& ctx) const {
+            while (cond->eval(ctx) != 0.0) {
+                ctx.step();
+                body->exec(ctx);
+                if (ctx.returning) break;
+            }
         }
-        void emitDOT(std::ostream& out, int& id, int parent) const override {
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
             int me = id++;
             out << "  n" << me << " [label=\"While\"];\n";
             if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
@@ -294,12 +449,163 @@ namespace AST {
         }
     };
 
+    //  . ĳ   ( ' AST::resolve),  exec   
+    struct Function : StmtImpl<Function> {
+        Type type;
+        std::string name;
+        std::vector<std::pair<Type, std::string>> params;
+        std::unique_ptr<Block> body;
+        std::uint32_t slots = 0;         // ,    
+        const Expr* inlineBody = nullptr; //     return:  
+        Function(Type t, std::string n, std::vector<std::pair<Type, std::string>>* ps, Block* b)
+            : type(t), name(std::move(n)), params(std::move(*ps)), body(b) {
+            delete ps;
+        }
+        template<class C> AST_BODY void execT(C&) const {}
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"Function(" << (type == Type::Int ? "int" : "double") << " " << name << "(";
+            for (std::size_t i = 0; i < params.size(); ++i)
+                out << (i ? ", " : "") << (params[i].first == Type::Int ? "int " : "double ") << params[i].second;
+            out << "))\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            body->emitDOT(out, id, me);
+        }
+    };
+
+    //     ,  ,        
+    struct Call : ExprImpl<Call> {
+        std::string name;
+        std::vector<std::unique_ptr<Expr>> args;
+        const Function* fn = nullptr;
+        Call(std::string n, std::vector<Expr*>* as) : name(std::move(n)) {
+            args.reserve(as->size());
+            for (Expr* e : *as) args.emplace_back(e);
+            delete as;
+        }
+        template<class C> AST_BODY double evalT(C& ctx) const {
+            ctx.step();
+            std::size_t base = ctx.reserve(fn->slots);
+            for (std::size_t i = 0; i < args.size(); ++i) {
+                double v = args[i]->eval(ctx);
+                ctx.frames[base + i] = v;
+            }
+            if (++ctx.depth > maxCallDepth) throw std::runtime_error("call depth exceeded");
+            std::size_t saved = ctx.frame;
+            ctx.frame = base;
+            fn->body->exec(ctx);
+            double r = ctx.returning ? ctx.result : 0.0;
+            ctx.returning = false;
+            ctx.frame = saved;
+            ctx.top = base;
+            --ctx.depth;
+            return r;
+        }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"Call(" << name << ")\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            for (auto& a : args) a->emitDOT(out, id, me);
+        }
+    };
+
+    struct Return : StmtImpl<Return> {
+        std::unique_ptr<Expr> value; // may be null
+        explicit Return(Expr* v) : value(v) {}
+        template<class C> AST_BODY void execT(C& ctx) const {
+            ctx.result = value ? value->eval(ctx) : 0.0;
+            ctx.returning = true;
+        }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"Return\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            if (value) value->emitDOT(out, id, me);
+        }
+    };
+
+    //    (f(x););        
+    struct ExprStmt : StmtImpl<ExprStmt> {
+        std::unique_ptr<Expr> expr;
+        explicit ExprStmt(Expr* e) : expr(e) {}
+        template<class C> AST_BODY void execT(C& ctx) const { expr->eval(ctx); }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"ExprStmt\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            expr->emitDOT(out, id, me);
+        }
+    };
+
+    //   ; id     AST::resolve (arrays.hpp)
+    struct ArrayDecl : StmtImpl<ArrayDecl> {
+        Type type;
+        std::string name;
+        std::uint32_t size = 0; // 0       [1, maxArray]
+        std::uint32_t id = 0;
+        ArrayDecl(Type t, std::string n, double length) : type(t), name(std::move(n)) {
+            if (length >= 1.0 && length <= maxArray && length == std::floor(length)) size = static_cast<std::uint32_t>(length);
+        }
+        template<class C> AST_BODY void execT(C& ctx) const { ctx.declareArray(id, name, size); }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"ArrayDecl(" << (type == Type::Int ? "int" : "double") << " " << name << "[" << static_cast<int>(size) << "])\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+        }
+    };
+
+    struct Index : ExprImpl<Index> {
+        std::string name;
+        std::unique_ptr<Expr> index;
+        const ArrayDecl* decl = nullptr;
+        bool checked = true; // false     
+        Index(std::string n, Expr* i) : name(std::move(n)), index(i) {}
+        template<class C> AST_BODY double evalT(C& ctx) const {
+            double i = index->eval(ctx);
+            std::size_t k = checked ? ctx.at(decl->id, name, i) : static_cast<std::size_t>(i);
+            return ctx.load(decl->id, name, k);
+        }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"Index(" << name << ")\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            index->emitDOT(out, id, me);
+        }
+    };
+
+    //  ,  ,       TAC
+    struct IndexAssign : StmtImpl<IndexAssign> {
+        std::string name;
+        std::unique_ptr<Expr> index, value;
+        const ArrayDecl* decl = nullptr;
+        bool checked = true;
+        IndexAssign(std::string n, Expr* i, Expr* v) : name(std::move(n)), index(i), value(v) {}
+        template<class C> AST_BODY void execT(C& ctx) const {
+            double i = index->eval(ctx);
+            double v = value->eval(ctx);
+            std::size_t k = checked ? ctx.at(decl->id, name, i) : static_cast<std::size_t>(i);
+            ctx.store(decl->id, name, k, v);
+        }
+        void emitDOT(IO::Writer& out, int& id, int parent) const override {
+            int me = id++;
+            out << "  n" << me << " [label=\"IndexAssign(" << name << ")\"];\n";
+            if (parent >= 0) out << "  n" << parent << " -> n" << me << ";\n";
+            index->emitDOT(out, id, me);
+            value->emitDOT(out, id, me);
+        }
+    };
+
     //    AST  .dot
-    inline void writeDOT(const Node& root, std::ostream& out) {
+    inline void writeDOT(const Node& root, IO::Writer& out) {
         out << "digraph AST {\n";
         int id = 0;
         root.emitDOT(out, id, -1);
         out << "}\n";
     }
 
+    inline void writeDOT(const Node& root, std::ostream& os) {
+        IO::Writer out(os);
+        writeDOT(root, out);
+    }
+
 } // namespace AST
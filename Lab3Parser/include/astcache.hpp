@@ -0,0 +1,511 @@
+// include/astcache.hpp
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <algorithm>
+#include <system_error>
+#include <thread>
+#include <functional>
+#include "ast.hpp"
+#include "funcs.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ASTCache {
+
+    //   AST: ,  ,    
+    // (post-order,     ),    Block   .
+    //  ,       mmap.
+    //  AST  AST::resolve; '      .
+    // '    64- ,    :   ,    AST.
+    constexpr std::uint32_t kVersion = 4;
+    constexpr char kMagic[4] = { 'L', '3', 'A', 'S' };
+
+    enum class Kind : std::uint8_t {
+        Number, Ident, Unary, Binary,
+        Block, VarDecl, Assign, Print, If, While,
+        Function, Call, Return, ExprStmt,
+        ArrayDecl, Index, IndexAssign
+    };
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t nodes;
+        std::uint32_t lists;
+        std::uint32_t strBytes;
+        std::uint32_t root;
+        std::uint32_t srcBytes; //     
+        std::uint32_t pad;
+    };
+
+    struct Rec {
+        Kind kind;
+        std::uint8_t op;   // BinOp/UnOp/Type, Ident: Ref
+        std::uint8_t flag; // Block: scoped, VarDecl: has init, If: has else, Return: has value
+        std::uint8_t pad;
+        std::uint32_t a, b, c;
+        double num;
+    };
+
+    static_assert(sizeof(Header) == 32 && sizeof(Rec) == 24, "cache layout");
+
+    inline std::uint64_t hashBytes(const char* p, std::size_t n) {
+        std::uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (std::size_t i = 0; i < n; ++i) { h ^= static_cast<unsigned char>(p[i]); h *= 1099511628211ull; }
+        h ^= kVersion; h *= 1099511628211ull;
+        return h;
+    }
+
+    // ---------- save ----------
+    struct Writer {
+        std::vector<Rec> recs;
+        std::vector<std::uint32_t> lists;
+        std::string strs;
+
+        std::uint32_t str(const std::string& s, std::uint32_t& len) {
+            auto off = static_cast<std::uint32_t>(strs.size());
+            strs += s;
+            len = static_cast<std::uint32_t>(s.size());
+            return off;
+        }
+
+        std::uint32_t push(Rec r) {
+            recs.push_back(r);
+            return static_cast<std::uint32_t>(recs.size() - 1);
+        }
+
+        std::uint32_t expr(const AST::Expr* e) {
+            using namespace AST;
+            Rec r{};
+            if (auto n = dynamic_cast<const Number*>(e)) { r.kind = Kind::Number; r.num = n->value; }
+            else if (auto id = dynamic_cast<const Ident*>(e)) {
+                r.kind = Kind::Ident; r.a = str(id->name, r.b);
+                r.op = static_cast<std::uint8_t>(id->ref);
+            }
+            else if (auto u = dynamic_cast<const Unary*>(e)) {
+                r.a = expr(u->E.get());
+                r.kind = Kind::Unary; r.op = static_cast<std::uint8_t>(u->op);
+            }
+            else if (auto b = dynamic_cast<const Binary*>(e)) {
+                r.a = expr(b->L.get());
+                r.b = expr(b->R.get());
+                r.kind = Kind::Binary; r.op = static_cast<std::uint8_t>(b->op);
+            }
+            else if (auto c = dynamic_cast<const Call*>(e)) {
+                // : ,  
+                std::vector<std::uint32_t> args;
+                for (auto& a : c->args) args.push_back(expr(a.get()));
+                r.kind = Kind::Call; r.a = str(c->name, r.b);
+                r.c = static_cast<std::uint32_t>(lists.size());
+                lists.push_back(static_cast<std::uint32_t>(args.size()));
+                lists.insert(lists.end(), args.begin(), args.end());
+            }
+            else if (auto ix = dynamic_cast<const Index*>(e)) {
+                r.c = expr(ix->index.get());
+                r.kind = Kind::Index; r.a = str(ix->name, r.b);
+            }
+            else throw std::runtime_error("cache: unsupported expression");
+            return push(r);
+        }
+
+        std::uint32_t stmt(const AST::Stmt* s) {
+            using namespace AST;
+            Rec r{};
+            if (auto bl = dynamic_cast<const Block*>(s)) {
+                std::vector<std::uint32_t> items;
+                for (auto& it : bl->items) items.push_back(stmt(it.get()));
+                r.kind = Kind::Block; r.flag = bl->createScope;
+                r.a = static_cast<std::uint32_t>(lists.size());
+                r.b = static_cast<std::uint32_t>(items.size());
+                lists.insert(lists.end(), items.begin(), items.end());
+            }
+            else if (auto vd = dynamic_cast<const VarDecl*>(s)) {
+                if (vd->init) { r.c = expr(vd->init.get()); r.flag = 1; }
+                r.kind = Kind::VarDecl; r.op = static_cast<std::uint8_t>(vd->type);
+                r.a = str(vd->name, r.b);
+            }
+            else if (auto as = dynamic_cast<const Assign*>(s)) {
+                r.c = expr(as->value.get());
+                r.kind = Kind::Assign; r.a = str(as->name, r.b);
+            }
+            else if (auto pr = dynamic_cast<const Print*>(s)) {
+                r.a = expr(pr->what.get());
+                r.kind = Kind::Print;
+            }
+            else if (auto iff = dynamic_cast<const AST::If*>(s)) {
+                r.a = expr(iff->cond.get());
+                r.b = stmt(iff->thenS.get());
+                if (iff->elseS) { r.c = stmt(iff->elseS.get()); r.flag = 1; }
+                r.kind = Kind::If;
+            }
+            else if (auto wh = dynamic_cast<const AST::While*>(s)) {
+                r.a = expr(wh->cond.get());
+                r.b = stmt(wh->body.get());
+                r.kind = Kind::While;
+            }
+            else if (auto fn = dynamic_cast<const AST::Function*>(s)) {
+                // : ,  ,  (, , )  
+                std::uint32_t body = stmt(fn->body.get());
+                r.kind = Kind::Function; r.op = static_cast<std::uint8_t>(fn->type);
+                r.a = str(fn->name, r.b);
+                r.c = static_cast<std::uint32_t>(lists.size());
+                lists.push_back(body);
+                lists.push_back(static_cast<std::uint32_t>(fn->params.size()));
+                for (auto& p : fn->params) {
+                    std::uint32_t len = 0;
+                    lists.push_back(static_cast<std::uint32_t>(p.first));
+                    lists.push_back(str(p.second, len));
+                    lists.push_back(len);
+                }
+            }
+            else if (auto rt = dynamic_cast<const AST::Return*>(s)) {
+                if (rt->value) { r.a = expr(rt->value.get()); r.flag = 1; }
+                r.kind = Kind::Return;
+            }
+            else if (auto es = dynamic_cast<const AST::ExprStmt*>(s)) {
+                r.a = expr(es->expr.get());
+                r.kind = Kind::ExprStmt;
+            }
+            else if (auto ad = dynamic_cast<const AST::ArrayDecl*>(s)) {
+                r.kind = Kind::ArrayDecl; r.op = static_cast<std::uint8_t>(ad->type);
+                r.a = str(ad->name, r.b);
+                r.num = ad->size;
+            }
+            else if (auto ia = dynamic_cast<const AST::IndexAssign*>(s)) {
+                // : , 
+                std::uint32_t i = expr(ia->index.get()), v = expr(ia->value.get());
+                r.kind = Kind::IndexAssign; r.a = str(ia->name, r.b);
+                r.c = static_cast<std::uint32_t>(lists.size());
+                lists.push_back(i);
+                lists.push_back(v);
+            }
+            else throw std::runtime_error("cache: unsupported statement");
+            return push(r);
+        }
+    };
+
+    inline std::vector<char> serialize(const AST::Block& root, const std::string& source) {
+        Writer w;
+        Header h{};
+        std::memcpy(h.magic, kMagic, 4);
+        h.version = kVersion;
+        h.root = w.stmt(&root);
+        h.nodes = static_cast<std::uint32_t>(w.recs.size());
+        h.lists = static_cast<std::uint32_t>(w.lists.size());
+        h.strBytes = static_cast<std::uint32_t>(w.strs.size());
+        h.srcBytes = static_cast<std::uint32_t>(source.size());
+
+        std::vector<char> out(sizeof(Header) + source.size() + w.recs.size() * sizeof(Rec) + w.lists.size() * 4 + w.strs.size());
+        char* p = out.data();
+        std::memcpy(p, &h, sizeof h); p += sizeof h;
+        std::memcpy(p, source.data(), source.size()); p += source.size();
+        std::memcpy(p, w.recs.data(), w.recs.size() * sizeof(Rec)); p += w.recs.size() * sizeof(Rec);
+        std::memcpy(p, w.lists.data(), w.lists.size() * 4); p += w.lists.size() * 4;
+        std::memcpy(p, w.strs.data(), w.strs.size());
+        return out;
+    }
+
+    // ---------- load ----------
+    //     :   ,  .
+    //    AST    nullptr (   ).
+    inline std::unique_ptr<AST::Block> deserialize(const char* data, std::size_t size, const std::string& source) {
+        if (size < sizeof(Header)) return nullptr;
+        Header h;
+        std::memcpy(&h, data, sizeof h);
+        if (std::memcmp(h.magic, kMagic, 4) != 0 || h.version != kVersion) return nullptr;
+        std::uint64_t need = sizeof(Header) + std::uint64_t(h.srcBytes) + std::uint64_t(h.nodes) * sizeof(Rec) + std::uint64_t(h.lists) * 4 + h.strBytes;
+        if (need != size || h.root >= h.nodes) return nullptr;
+        if (h.srcBytes != source.size() || std::memcmp(data + sizeof(Header), source.data(), source.size()) != 0) return nullptr;
+
+        const char* recBase = data + sizeof(Header) + h.srcBytes;
+        const char* listBase = recBase + std::size_t(h.nodes) * sizeof(Rec);
+        const char* strBase = listBase + std::size_t(h.lists) * 4;
+
+        std::vector<std::unique_ptr<AST::Node>> built(h.nodes);
+        bool bind = false;
+        auto isExpr = [](Kind k) { return k <= Kind::Binary || k == Kind::Call || k == Kind::Index; };
+        std::vector<Kind> kinds(h.nodes);
+
+        auto takeE = [&](std::uint32_t i, std::uint32_t self) -> AST::Expr* {
+            if (i >= self || !built[i] || !isExpr(kinds[i])) return nullptr;
+            return static_cast<AST::Expr*>(built[i].release());
+        };
+        auto takeS = [&](std::uint32_t i, std::uint32_t self) -> AST::Stmt* {
+            if (i >= self || !built[i] || isExpr(kinds[i])) return nullptr;
+            return static_cast<AST::Stmt*>(built[i].release());
+        };
+        auto name = [&](const Rec& r, std::string& s) {
+            if (std::uint64_t(r.a) + r.b > h.strBytes) return false;
+            s.assign(strBase + r.a, r.b);
+            return true;
+        };
+        auto list = [&](std::uint64_t at) {
+            std::uint32_t v;
+            std::memcpy(&v, listBase + std::size_t(at) * 4, 4);
+            return v;
+        };
+
+        for (std::uint32_t i = 0; i < h.nodes; ++i) {
+            Rec r;
+            std::memcpy(&r, recBase + std::size_t(i) * sizeof(Rec), sizeof r);
+            kinds[i] = r.kind;
+            bind = bind || r.kind >= Kind::Function;
+            std::string s;
+            switch (r.kind) {
+            case Kind::Number: built[i].reset(new AST::Number(r.num)); break;
+            case Kind::Ident:
+            {
+                if (!name(r, s) || r.op > static_cast<std::uint8_t>(AST::Ref::Global)) return nullptr;
+                auto id = std::make_unique<AST::Ident>(std::move(s));
+                id->ref = static_cast<AST::Ref>(r.op);
+                built[i] = std::move(id);
+                break;
+            }
+            case Kind::Unary: {
+                auto e = takeE(r.a, i);
+                if (!e || r.op > static_cast<std::uint8_t>(AST::UnOp::Not)) { delete e; return nullptr; }
+                built[i].reset(new AST::Unary(static_cast<AST::UnOp>(r.op), e));
+                break;
+            }
+            case Kind::Binary: {
+                auto l = takeE(r.a, i);
+                auto rr = takeE(r.b, i);
+                if (!l || !rr || r.op > static_cast<std::uint8_t>(AST::BinOp::Or)) { delete l; delete rr; return nullptr; }
+                built[i].reset(new AST::Binary(static_cast<AST::BinOp>(r.op), l, rr));
+                break;
+            }
+            case Kind::Block: {
+                if (std::uint64_t(r.a) + r.b > h.lists) return nullptr;
+                auto bl = std::make_unique<AST::Block>(r.flag != 0);
+                for (std::uint32_t k = 0; k < r.b; ++k) {
+                    std::uint32_t idx;
+                    std::memcpy(&idx, listBase + std::size_t(r.a + k) * 4, 4);
+                    auto st = takeS(idx, i);
+                    if (!st) return nullptr;
+                    bl->add(st);
+                }
+                built[i] = std::move(bl);
+                break;
+            }
+            case Kind::VarDecl: {
+                AST::Expr* e = nullptr;
+                if (r.flag && !(e = takeE(r.c, i))) return nullptr;
+                if (!name(r, s)) { delete e; return nullptr; }
+                built[i].reset(new AST::VarDecl(r.op ? AST::Type::Double : AST::Type::Int, std::move(s), e));
+                break;
+            }
+            case Kind::Assign: {
+                auto e = takeE(r.c, i);
+                if (!e || !name(r, s)) { delete e; return nullptr; }
+                built[i].reset(new AST::Assign(std::move(s), e));
+                break;
+            }
+            case Kind::Print: {
+                auto e = takeE(r.a, i);
+                if (!e) return nullptr;
+                built[i].reset(new AST::Print(e));
+                break;
+            }
+            case Kind::If: {
+                auto c = takeE(r.a, i);
+                auto t = takeS(r.b, i);
+                AST::Stmt* el = r.flag ? takeS(r.c, i) : nullptr;
+                if (!c || !t || (r.flag && !el)) { delete c; delete t; delete el; return nullptr; }
+                built[i].reset(new AST::If(c, t, el));
+                break;
+            }
+            case Kind::While: {
+                auto c = takeE(r.a, i);
+                auto b = takeS(r.b, i);
+                if (!c || !b) { delete c; delete b; return nullptr; }
+                built[i].reset(new AST::While(c, b));
+                break;
+            }
+            case Kind::Function: {
+                if (std::uint64_t(r.c) + 2 > h.lists || !name(r, s)) return nullptr;
+                std::uint64_t n = list(r.c + 1);
+                if (r.c + 2 + n * 3 > h.lists) return nullptr;
+                auto ps = new std::vector<std::pair<AST::Type, std::string>>();
+                for (std::uint64_t k = 0; k < n; ++k) {
+                    auto at = r.c + 2 + k * 3;
+                    std::uint32_t off = list(at + 1), len = list(at + 2);
+                    if (std::uint64_t(off) + len > h.strBytes) { delete ps; return nullptr; }
+                    ps->emplace_back(list(at) ? AST::Type::Double : AST::Type::Int, std::string(strBase + off, len));
+                }
+                auto body = takeS(list(r.c), i);
+                if (!body || kinds[list(r.c)] != Kind::Block) { delete body; delete ps; return nullptr; }
+                built[i].reset(new AST::Function(r.op ? AST::Type::Double : AST::Type::Int, std::move(s), ps,
+                    static_cast<AST::Block*>(body)));
+                break;
+            }
+            case Kind::Call: {
+                if (std::uint64_t(r.c) + 1 > h.lists || !name(r, s)) return nullptr;
+                std::uint64_t n = list(r.c);
+                if (r.c + 1 + n > h.lists) return nullptr;
+                auto args = new std::vector<AST::Expr*>();
+                for (std::uint64_t k = 0; k < n; ++k) {
+                    auto e = takeE(list(r.c + 1 + k), i);
+                    if (!e) { for (auto a : *args) delete a; delete args; return nullptr; }
+                    args->push_back(e);
+                }
+                built[i].reset(new AST::Call(std::move(s), args));
+                break;
+            }
+            case Kind::Return: {
+                AST::Expr* e = nullptr;
+                if (r.flag && !(e = takeE(r.a, i))) return nullptr;
+                built[i].reset(new AST::Return(e));
+                break;
+            }
+            case Kind::ExprStmt: {
+                auto e = takeE(r.a, i);
+                if (!e) return nullptr;
+                built[i].reset(new AST::ExprStmt(e));
+                break;
+            }
+            case Kind::ArrayDecl:
+                if (!name(r, s)) return nullptr;
+                built[i].reset(new AST::ArrayDecl(r.op ? AST::Type::Double : AST::Type::Int, std::move(s), r.num));
+                break;
+            case Kind::Index: {
+                auto e = takeE(r.c, i);
+                if (!e || !name(r, s)) { delete e; return nullptr; }
+                built[i].reset(new AST::Index(std::move(s), e));
+                break;
+            }
+            case Kind::IndexAssign: {
+                if (std::uint64_t(r.c) + 2 > h.lists || !name(r, s)) return nullptr;
+                auto ix = takeE(list(r.c), i);
+                auto v = takeE(list(r.c + 1), i);
+                if (!ix || !v) { delete ix; delete v; return nullptr; }
+                built[i].reset(new AST::IndexAssign(std::move(s), ix, v));
+                break;
+            }
+            default: return nullptr;
+            }
+        }
+
+        if (kinds[h.root] != Kind::Block || !built[h.root]) return nullptr;
+        std::unique_ptr<AST::Block> root(static_cast<AST::Block*>(built[h.root].release()));
+        if (!bind) return root;
+        try { AST::resolve(*root); }
+        catch (const std::runtime_error&) { return nullptr; }
+        return root;
+    }
+
+    // ----------   ----------
+    //   :      ,  
+    inline std::string tmpTag() {
+#ifdef _WIN32
+        auto pid = static_cast<unsigned long>(_getpid());
+#else
+        auto pid = static_cast<unsigned long>(::getpid());
+#endif
+        auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return "." + std::to_string(pid) + "." + std::to_string(tid);
+    }
+
+    struct Store {
+        std::filesystem::path dir;
+        std::uintmax_t maxBytes = 64u << 20;
+        bool autoEvict = true; // false  evict()   (.   --batch)
+
+        std::filesystem::path pathFor(std::uint64_t key) const {
+            char buf[32];
+            std::snprintf(buf, sizeof buf, "%016llx.ast", static_cast<unsigned long long>(key));
+            return dir / buf;
+        }
+
+        // source  ,    AST; key  hashBytes  
+        std::unique_ptr<AST::Block> load(std::uint64_t key, const std::string& source) const {
+            auto p = pathFor(key);
+            std::unique_ptr<AST::Block> res;
+#ifndef _WIN32
+            int fd = ::open(p.c_str(), O_RDONLY);
+            if (fd < 0) return nullptr;
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* m = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (m != MAP_FAILED) {
+                    res = deserialize(static_cast<const char*>(m), static_cast<std::size_t>(st.st_size), source);
+                    ::munmap(m, static_cast<std::size_t>(st.st_size));
+                }
+            }
+            ::close(fd);
+#else
+            FILE* f = nullptr;
+            if (_wfopen_s(&f, p.c_str(), L"rb") != 0 || !f) return nullptr;
+            std::vector<char> buf;
+            char chunk[65536];
+            std::size_t n;
+            while ((n = std::fread(chunk, 1, sizeof chunk, f)) > 0) buf.insert(buf.end(), chunk, chunk + n);
+            std::fclose(f);
+            res = deserialize(buf.data(), buf.size(), source);
+#endif
+            if (res) {
+                std::error_code ec; //  LRU-
+                std::filesystem::last_write_time(p, std::filesystem::file_time_type::clock::now(), ec);
+            }
+            return res;
+        }
+
+        void save(std::uint64_t key, const std::string& source, const AST::Block& root) const {
+            if (source.size() > UINT32_MAX) return;
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            auto bytes = serialize(root, source);
+            auto p = pathFor(key);
+            auto tmp = p; tmp += tmpTag() + ".tmp";
+            {
+                FILE* f = nullptr;
+#ifdef _MSC_VER
+                if (fopen_s(&f, tmp.string().c_str(), "wb") != 0) f = nullptr;
+#else
+                f = std::fopen(tmp.c_str(), "wb");
+#endif
+                if (!f) return;
+                bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+                ok = std::fclose(f) == 0 && ok;
+                if (!ok) { std::filesystem::remove(tmp, ec); return; }
+            }
+            std::filesystem::rename(tmp, p, ec); //    
+            if (ec) std::filesystem::remove(tmp, ec);
+            if (autoEvict) evict();
+        }
+
+        //    (.ast,  --memo .out   --aot .so),     
+        void evict() const {
+            std::error_code ec;
+            struct Entry { std::filesystem::path p; std::uintmax_t size; std::filesystem::file_time_type t; };
+            std::vector<Entry> all;
+            std::uintmax_t total = 0;
+            for (auto& de : std::filesystem::directory_iterator(dir, ec)) {
+                auto ext = de.path().extension();
+                if (!de.is_regular_file(ec) || (ext != ".ast" && ext != ".out" && ext != ".so")) continue;
+                Entry e{ de.path(), de.file_size(ec), de.last_write_time(ec) };
+                total += e.size;
+                all.push_back(std::move(e));
+            }
+            if (total <= maxBytes) return;
+            std::sort(all.begin(), all.end(), [](const Entry& a, const Entry& b) { return a.t < b.t; });
+            for (auto& e : all) {
+                if (total <= maxBytes) break;
+                if (std::filesystem::remove(e.p, ec)) total -= e.size;
+            }
+        }
+    };
+
+} // namespace ASTCache
@@ -0,0 +1,142 @@
+// include/cfg.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <unordered_map>
+#include "tac.hpp"
+
+namespace TAC {
+
+    //     Unit::code.      
+    //       ;  0  .
+    struct CFG {
+        struct Block {
+            std::size_t begin = 0, end = 0; // [begin, end)  Unit::code
+            std::vector<std::size_t> succ, pred;
+            bool reachable = false;
+        };
+
+        std::vector<Block> blocks;
+        std::unordered_map<std::uint32_t, std::size_t> blockOf; //  -> 
+
+        CFG() = default;
+        explicit CFG(const Unit& u) { build(u); }
+
+        void build(const Unit& u) {
+            blocks.clear();
+            blockOf.clear();
+            const auto& code = u.code;
+            std::size_t start = 0;
+            for (std::size_t i = 0; i < code.size(); ++i) {
+                const Instr& in = code[i];
+                if (in.op == Op::Label) {
+                    //     
+                    bool lead = i > start && code[i - 1].op != Op::Label;
+                    if (i > start && lead) { push(start, i); start = i; }
+                    blockOf[in.label] = blocks.size();
+                }
+                if (isJump(in.op)) { push(start, i + 1); start = i + 1; }
+            }
+            if (start < code.size() || blocks.empty()) push(start, code.size());
+
+            for (std::size_t b = 0; b < blocks.size(); ++b) {
+                auto& bl = blocks[b];
+                if (bl.begin == bl.end) continue;
+                const Instr& last = code[bl.end - 1];
+                if (isJump(last.op)) {
+                    auto f = blockOf.find(last.label);
+                    if (f != blockOf.end()) edge(b, f->second);
+                }
+                if (last.op != Op::Goto && b + 1 < blocks.size()) edge(b, b + 1);
+            }
+
+            //   
+            std::vector<std::size_t> work{ 0 };
+            blocks[0].reachable = true;
+            while (!work.empty()) {
+                auto b = work.back(); work.pop_back();
+                for (auto s : blocks[b].succ)
+                    if (!blocks[s].reachable) { blocks[s].reachable = true; work.push_back(s); }
+            }
+        }
+
+        //    :  -  
+        static std::size_t firstReal(const std::vector<Instr>& code, std::size_t i) {
+            while (i < code.size() && code[i].op == Op::Label) ++i;
+            return i;
+        }
+
+    private:
+        void push(std::size_t b, std::size_t e) { Block bl; bl.begin = b; bl.end = e; blocks.push_back(bl); }
+        void edge(std::size_t a, std::size_t b) {
+            for (auto s : blocks[a].succ) if (s == b) return;
+            blocks[a].succ.push_back(b);
+            blocks[b].pred.push_back(a);
+        }
+    };
+
+    //    tN    (,   
+    // ,  tN    ). : Var -> index, Temp -> vars + index.
+    struct Liveness {
+        std::vector<std::vector<std::uint32_t>> in, out;
+
+        static std::uint32_t keys(const Unit& u) { return static_cast<std::uint32_t>(u.vars.size()) + u.temps + 1; }
+        static std::uint32_t key(const Unit& u, const Operand& o) {
+            return o.kind == Operand::Kind::Var ? o.index : static_cast<std::uint32_t>(u.vars.size()) + o.index;
+        }
+        static bool isName(const Operand& o) {
+            return o.kind == Operand::Kind::Var || o.kind == Operand::Kind::Temp;
+        }
+
+        Liveness(const Unit& u, const CFG& cfg) {
+            auto& bs = cfg.blocks;
+            std::vector<std::vector<std::uint32_t>> gen(bs.size()), kill(bs.size());
+            std::vector<char> mark(keys(u), 0);
+            in.assign(bs.size(), {});
+            out.assign(bs.size(), {});
+
+            for (std::size_t b = 0; b < bs.size(); ++b) {
+                auto use = [&](const Operand& o) {
+                    if (!isName(o)) return;
+                    auto k = key(u, o);
+                    if (mark[k] == 0) { mark[k] = 1; gen[b].push_back(k); }
+                };
+                for (std::size_t i = bs[b].begin; i < bs[b].end; ++i) {
+                    const Instr& ins = u.code[i];
+                    if (readsA(ins.op)) use(ins.a);
+                    if (readsB(ins.op)) use(ins.b);
+                    if (definesDst(ins.op)) {
+                        auto k = key(u, ins.dst);
+                        if (mark[k] == 0) { mark[k] = 2; kill[b].push_back(k); }
+                    }
+                }
+                for (auto k : gen[b]) mark[k] = 0;
+                for (auto k : kill[b]) mark[k] = 0;
+                std::sort(gen[b].begin(), gen[b].end());
+                std::sort(kill[b].begin(), kill[b].end());
+                in[b] = gen[b];
+            }
+
+            std::vector<std::uint32_t> tmp, rest, next;
+            for (bool again = true; again;) {
+                again = false;
+                for (std::size_t b = bs.size(); b-- > 0;) {
+                    auto& o = out[b];
+                    o.clear();
+                    for (auto s : bs[b].succ) {
+                        tmp.clear();
+                        std::set_union(o.begin(), o.end(), in[s].begin(), in[s].end(), std::back_inserter(tmp));
+                        o.swap(tmp);
+                    }
+                    rest.clear(); next.clear();
+                    std::set_difference(o.begin(), o.end(), kill[b].begin(), kill[b].end(), std::back_inserter(rest));
+                    std::set_union(rest.begin(), rest.end(), gen[b].begin(), gen[b].end(), std::back_inserter(next));
+                    if (next != in[b]) { in[b].swap(next); again = true; }
+                }
+            }
+        }
+    };
+
+} // namespace TAC
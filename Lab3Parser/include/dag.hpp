@@ -0,0 +1,160 @@
+// include/dag.hpp
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "ast.hpp"
+
+namespace DAG {
+
+    enum class Kind : std::uint8_t { Number, Ident, Unary, Binary, Call, Index };
+
+    //  DAG:      ,   
+    struct Node {
+        Kind kind = Kind::Number;
+        int op = 0;              // BinOp/UnOp, Ident: AST::Ref, Index:  
+        std::uint64_t bits = 0;  // Number:  double, Ident:  , Call:  , Index: ArrayDecl
+        int L = -1, R = -1;
+        std::size_t hash = 0;
+
+        bool operator==(const Node& o) const {
+            return kind == o.kind && op == o.op && bits == o.bits && L == o.L && R == o.R;
+        }
+    };
+
+    struct NodeHash {
+        std::size_t operator()(const Node& n) const { return n.hash; }
+    };
+
+    // - :     
+    struct Graph {
+        std::vector<Node> nodes;
+        std::vector<std::string> names;
+        std::unordered_map<const AST::Expr*, int> ids; //  AST -> 
+
+        std::size_t treeNodes = 0; //  -  
+        std::size_t treeBytes = 0;
+
+        int idOf(const AST::Expr* e) const {
+            auto f = ids.find(e);
+            return f == ids.end() ? -1 : f->second;
+        }
+
+        std::size_t dagBytes() const {
+            std::size_t b = nodes.size() * sizeof(Node);
+            for (auto& n : names) b += sizeof(std::string) + (n.size() > 15 ? n.capacity() : 0);
+            return b;
+        }
+
+        void build(const AST::Stmt* s) {
+            using namespace AST;
+
+            if (auto vd = dynamic_cast<const VarDecl*>(s)) { if (vd->init) intern(vd->init.get()); return; }
+            if (auto as = dynamic_cast<const Assign*>(s)) { intern(as->value.get()); return; }
+            if (auto pr = dynamic_cast<const Print*>(s)) { intern(pr->what.get()); return; }
+            if (auto es = dynamic_cast<const ExprStmt*>(s)) { intern(es->expr.get()); return; }
+            if (auto ia = dynamic_cast<const IndexAssign*>(s)) { intern(ia->index.get()); intern(ia->value.get()); return; }
+            if (auto iff = dynamic_cast<const AST::If*>(s)) {
+                intern(iff->cond.get());
+                build(iff->thenS.get());
+                if (iff->elseS) build(iff->elseS.get());
+                return;
+            }
+            if (auto wh = dynamic_cast<const AST::While*>(s)) {
+                intern(wh->cond.get());
+                build(wh->body.get());
+                return;
+            }
+            if (auto bl = dynamic_cast<const Block*>(s)) {
+                for (auto& it : bl->items) build(it.get());
+            }
+            //     DAG
+        }
+
+        int intern(const AST::Expr* e) {
+            using namespace AST;
+
+            Node n;
+            ++treeNodes;
+            if (auto num = dynamic_cast<const Number*>(e)) {
+                treeBytes += sizeof(Number);
+                n.kind = Kind::Number;
+                std::memcpy(&n.bits, &num->value, sizeof(double));
+            }
+            else if (auto id = dynamic_cast<const Ident*>(e)) {
+                treeBytes += sizeof(Ident) + (id->name.size() > 15 ? id->name.capacity() : 0);
+                n.kind = Kind::Ident;
+                n.op = static_cast<int>(id->ref);
+                n.bits = nameId(id->name);
+            }
+            else if (auto u = dynamic_cast<const Unary*>(e)) {
+                treeBytes += sizeof(Unary);
+                n.kind = Kind::Unary;
+                n.op = static_cast<int>(u->op);
+                n.L = intern(u->E.get());
+            }
+            else if (auto b = dynamic_cast<const Binary*>(e)) {
+                treeBytes += sizeof(Binary);
+                n.kind = Kind::Binary;
+                n.op = static_cast<int>(b->op);
+                n.L = intern(b->L.get());
+                n.R = intern(b->R.get());
+            }
+            else if (auto c = dynamic_cast<const Call*>(e)) {
+                //     :      
+                treeBytes += sizeof(Call) + c->args.capacity() * sizeof(c->args[0]);
+                for (auto& a : c->args) intern(a.get());
+                n.kind = Kind::Call;
+                n.bits = calls++;
+            }
+            else if (auto ix = dynamic_cast<const Index*>(e)) {
+                //      ,     a[i]   
+                treeBytes += sizeof(Index) + (ix->name.size() > 15 ? ix->name.capacity() : 0);
+                n.kind = Kind::Index;
+                n.op = ix->checked ? 0 : 1;
+                n.bits = reinterpret_cast<std::uintptr_t>(ix->decl);
+                n.L = intern(ix->index.get());
+            }
+            n.hash = mix(n);
+
+            auto f = table.find(n);
+            int id;
+            if (f != table.end()) id = f->second;
+            else {
+                id = static_cast<int>(nodes.size());
+                nodes.push_back(n);
+                table.emplace(n, id);
+            }
+            ids[e] = id;
+            return id;
+        }
+
+    private:
+        std::unordered_map<Node, int, NodeHash> table;
+        std::unordered_map<std::string, int> nameIds;
+        std::uint64_t calls = 0;
+
+        std::uint64_t nameId(const std::string& s) {
+            auto f = nameIds.find(s);
+            if (f != nameIds.end()) return static_cast<std::uint64_t>(f->second);
+            int id = static_cast<int>(names.size());
+            names.push_back(s);
+            nameIds.emplace(s, id);
+            return static_cast<std::uint64_t>(id);
+        }
+
+        static std::size_t mix(const Node& n) {
+            std::size_t h = static_cast<std::size_t>(n.kind) * 0x9E3779B97F4A7C15ull;
+            auto add = [&h](std::uint64_t v) { h ^= std::hash<std::uint64_t>{}(v) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2); };
+            add(static_cast<std::uint64_t>(n.op));
+            add(n.bits);
+            add(static_cast<std::uint64_t>(n.L + 1));
+            add(static_cast<std::uint64_t>(n.R + 1));
+            return h;
+        }
+    };
+
+} // namespace DAG
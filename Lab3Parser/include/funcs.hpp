@@ -0,0 +1,252 @@
+// include/funcs.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <stdexcept>
+#include "ast.hpp"
+#include "arrays.hpp"
+
+namespace AST {
+
+    // ϳ ,  :      ( 
+    // ),  '  ,      
+    // (Ref::Local)    (Ref::Global).   std::runtime_error.
+    //   -     (Inliner).
+    class Resolver {
+    public:
+        void run(Block& root) {
+            funcs.clear();
+            for (auto& s : root.items)
+                if (auto f = dynamic_cast<Function*>(s.get())) {
+                    if (!funcs.emplace(f->name, f).second) throw std::runtime_error("function redefinition: " + f->name);
+                }
+            for (auto& f : funcs) function(*f.second);
+            cur = nullptr;
+            for (auto& s : root.items)
+                if (!dynamic_cast<Function*>(s.get())) stmt(s.get());
+        }
+
+    private:
+        using Scope = std::unordered_map<std::string, std::uint32_t>;
+
+        std::unordered_map<std::string, Function*> funcs;
+        Function* cur = nullptr;
+        std::vector<Scope> scopes; //    
+
+        void function(Function& f) {
+            cur = &f;
+            scopes.assign(1, Scope());
+            f.slots = 0;
+            for (auto& p : f.params)
+                if (!scopes[0].emplace(p.second, f.slots++).second) throw std::runtime_error("duplicate parameter: " + p.second);
+            //       ,   C
+            f.body->createScope = false;
+            for (auto& s : f.body->items) stmt(s.get());
+            scopes.clear();
+        }
+
+        // Ref::Local  ,  '  ;  Global
+        void lookup(const std::string& name, Ref& ref, std::uint32_t& slot) const {
+            for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+                auto f = it->find(name);
+                if (f != it->end()) { ref = Ref::Local; slot = f->second; return; }
+            }
+            ref = Ref::Global;
+            slot = 0;
+        }
+
+        void expr(Expr* e) {
+            if (auto id = dynamic_cast<Ident*>(e)) {
+                // Global      (  AST): '     
+                if (cur && id->ref != Ref::Global) lookup(id->name, id->ref, id->slot);
+            }
+            else if (auto u = dynamic_cast<Unary*>(e)) expr(u->E.get());
+            else if (auto b = dynamic_cast<Binary*>(e)) { expr(b->L.get()); expr(b->R.get()); }
+            else if (auto c = dynamic_cast<Call*>(e)) {
+                auto f = funcs.find(c->name);
+                if (f == funcs.end()) throw std::runtime_error("undefined function: " + c->name);
+                c->fn = f->second;
+                if (c->args.size() != c->fn->params.size())
+                    throw std::runtime_error(c->name + " expects " + std::to_string(c->fn->params.size()) +
+                        " arguments, got " + std::to_string(c->args.size()));
+                for (auto& a : c->args) expr(a.get());
+            }
+            else if (auto ix = dynamic_cast<Index*>(e)) expr(ix->index.get());
+        }
+
+        void stmt(Stmt* s) {
+            if (auto b = dynamic_cast<Block*>(s)) {
+                if (!cur) { for (auto& i : b->items) stmt(i.get()); return; }
+                b->createScope = false; //     
+                scopes.emplace_back();
+                for (auto& i : b->items) stmt(i.get());
+                scopes.pop_back();
+            }
+            else if (auto d = dynamic_cast<VarDecl*>(s)) {
+                if (d->init) expr(d->init.get());
+                if (!cur) return;
+                if (!scopes.back().emplace(d->name, cur->slots).second)
+                    throw std::runtime_error("redeclaration in the same scope: " + d->name);
+                d->ref = Ref::Local;
+                d->slot = cur->slots++;
+            }
+            else if (auto a = dynamic_cast<Assign*>(s)) {
+                expr(a->value.get());
+                if (cur) lookup(a->name, a->ref, a->slot);
+            }
+            else if (auto p = dynamic_cast<Print*>(s)) expr(p->what.get());
+            else if (auto i = dynamic_cast<If*>(s)) {
+                expr(i->cond.get());
+                stmt(i->thenS.get());
+                if (i->elseS) stmt(i->elseS.get());
+            }
+            else if (auto w = dynamic_cast<While*>(s)) { expr(w->cond.get()); stmt(w->body.get()); }
+            else if (auto r = dynamic_cast<Return*>(s)) {
+                if (!cur) throw std::runtime_error("return outside a function");
+                if (r->value) expr(r->value.get());
+            }
+            else if (auto x = dynamic_cast<ExprStmt*>(s)) expr(x->expr.get());
+            else if (auto ia = dynamic_cast<IndexAssign*>(s)) { expr(ia->index.get()); expr(ia->value.get()); }
+        }
+    };
+
+    // ϳ:     return    maxNodes  
+    //    (    ),     .
+    //  ,        ,  :
+    // ;  ; / ,     (
+    // "undefined variable" );      , 
+    //     .   .
+    class Inliner {
+    public:
+        static constexpr std::size_t maxNodes = 24;
+        std::size_t inlined = 0;
+
+        void run(Block& root) {
+            for (auto& s : root.items) stmt(s.get());
+        }
+
+    private:
+        enum class State : std::uint8_t { Fresh, Visiting, Done };
+        std::unordered_map<const Function*, State> state;
+
+        static std::size_t size(const Expr* e) {
+            if (auto u = dynamic_cast<const Unary*>(e)) return 1 + size(u->E.get());
+            if (auto b = dynamic_cast<const Binary*>(e)) return 1 + size(b->L.get()) + size(b->R.get());
+            if (auto c = dynamic_cast<const Call*>(e)) {
+                std::size_t n = 1;
+                for (auto& a : c->args) n += size(a.get());
+                return n;
+            }
+            return 1;
+        }
+
+        //  , ,     ,  쳺 clone
+        static bool plain(const Expr* e) {
+            if (dynamic_cast<const Number*>(e) || dynamic_cast<const Ident*>(e)) return true;
+            if (auto u = dynamic_cast<const Unary*>(e)) return plain(u->E.get());
+            if (auto b = dynamic_cast<const Binary*>(e)) return plain(b->L.get()) && plain(b->R.get());
+            return false;
+        }
+
+        //     : ,  ,   
+        static bool pure(const Expr* e) {
+            if (dynamic_cast<const Number*>(e)) return true;
+            if (auto id = dynamic_cast<const Ident*>(e)) return id->ref == Ref::Local;
+            if (auto u = dynamic_cast<const Unary*>(e)) return pure(u->E.get());
+            if (auto b = dynamic_cast<const Binary*>(e)) return b->op != BinOp::Div && pure(b->L.get()) && pure(b->R.get());
+            return false;
+        }
+
+        //      
+        static void uses(const Expr* e, std::vector<std::uint32_t>& n) {
+            if (auto id = dynamic_cast<const Ident*>(e)) {
+                if (id->ref == Ref::Local && id->slot < n.size()) ++n[id->slot];
+            }
+            else if (auto u = dynamic_cast<const Unary*>(e)) uses(u->E.get(), n);
+            else if (auto b = dynamic_cast<const Binary*>(e)) { uses(b->L.get(), n); uses(b->R.get(), n); }
+        }
+
+        static std::unique_ptr<Expr> clone(const Expr* e, const std::vector<std::unique_ptr<Expr>>* args) {
+            if (auto n = dynamic_cast<const Number*>(e)) return std::make_unique<Number>(n->value);
+            if (auto id = dynamic_cast<const Ident*>(e)) {
+                if (args && id->ref == Ref::Local) return clone((*args)[id->slot].get(), nullptr);
+                auto c = std::make_unique<Ident>(id->name);
+                c->ref = id->ref;
+                c->slot = id->slot;
+                return c;
+            }
+            if (auto u = dynamic_cast<const Unary*>(e)) return std::make_unique<Unary>(u->op, clone(u->E.get(), args));
+            auto b = static_cast<const Binary*>(e);
+            return std::make_unique<Binary>(b->op, clone(b->L.get(), args), clone(b->R.get(), args));
+        }
+
+        // ҳ    nullptr
+        const Expr* body(Function* f) {
+            auto& st = state[f];
+            if (st == State::Done) return f->inlineBody;
+            if (st == State::Visiting) return nullptr; // 
+            st = State::Visiting;
+            for (auto& s : f->body->items) stmt(s.get());
+            const Expr* e = nullptr;
+            if (f->body->items.size() == 1)
+                if (auto r = dynamic_cast<Return*>(f->body->items[0].get()))
+                    if (r->value && plain(r->value.get()) && size(r->value.get()) <= maxNodes) e = r->value.get();
+            f->inlineBody = e;
+            state[f] = State::Done;
+            return e;
+        }
+
+        void expr(std::unique_ptr<Expr>& e) {
+            if (auto u = dynamic_cast<Unary*>(e.get())) { expr(u->E); return; }
+            if (auto b = dynamic_cast<Binary*>(e.get())) { expr(b->L); expr(b->R); return; }
+            if (auto ix = dynamic_cast<Index*>(e.get())) { expr(ix->index); return; }
+            auto c = dynamic_cast<Call*>(e.get());
+            if (!c) return;
+            for (auto& a : c->args) expr(a);
+            auto fn = const_cast<Function*>(c->fn);
+            const Expr* b = body(fn);
+            if (!b) return;
+            std::vector<std::uint32_t> n(c->args.size(), 0);
+            uses(b, n);
+            for (std::size_t i = 0; i < c->args.size(); ++i) {
+                const Expr* a = c->args[i].get();
+                if (dynamic_cast<const Number*>(a)) continue;
+                if (auto id = dynamic_cast<const Ident*>(a)) {
+                    if (id->ref == Ref::Local || n[i] > 0) continue;
+                    return;
+                }
+                if (n[i] > 1 || !pure(a)) return;
+            }
+            e = clone(b, &c->args);
+            ++inlined;
+        }
+
+        void stmt(Stmt* s) {
+            if (auto b = dynamic_cast<Block*>(s)) for (auto& i : b->items) stmt(i.get());
+            else if (auto d = dynamic_cast<VarDecl*>(s)) { if (d->init) expr(d->init); }
+            else if (auto a = dynamic_cast<Assign*>(s)) expr(a->value);
+            else if (auto p = dynamic_cast<Print*>(s)) expr(p->what);
+            else if (auto i = dynamic_cast<If*>(s)) {
+                expr(i->cond);
+                stmt(i->thenS.get());
+                if (i->elseS) stmt(i->elseS.get());
+            }
+            else if (auto w = dynamic_cast<While*>(s)) { expr(w->cond); stmt(w->body.get()); }
+            else if (auto r = dynamic_cast<Return*>(s)) { if (r->value) expr(r->value); }
+            else if (auto x = dynamic_cast<ExprStmt*>(s)) expr(x->expr);
+            else if (auto f = dynamic_cast<Function*>(s)) body(f);
+            else if (auto ia = dynamic_cast<IndexAssign*>(s)) { expr(ia->index); expr(ia->value); }
+        }
+    };
+
+    // '  ,       
+    inline void resolve(Block& root) {
+        Resolver().run(root);
+        Inliner().run(root);
+        Arrays().run(root);
+    }
+
+} // namespace AST
@@ -0,0 +1,279 @@
+// include/lab3.hpp
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <streambuf>
+#include <stdexcept>
+#include "ast.hpp"
+#include "funcs.hpp"
+#include "scopes.hpp"
+#include "tac.hpp"
+#include "tacopt.hpp"
+#include "vm.hpp"
+#include "parexec.hpp"
+#include "lanes.hpp"
+#include "../generated/parser.hpp"
+
+// ,   Flex/Bison (generated/lexer.cpp, generated/parser.cpp)
+extern int yyparse(void);
+extern int yylex(void);
+extern int yylex_destroy(void);
+struct yy_buffer_state;
+extern yy_buffer_state* yy_scan_bytes(const char* bytes, int len);
+
+//   AST   ,   parser.y
+extern AST::Block* g_root;
+extern std::string* g_parseErrors;
+extern int g_resolveNodes;
+
+//  : compile()  , run()     - .
+//   flex/bison  ,    Program.
+namespace Lab3 {
+
+    // flex/bison   ,     
+    inline std::mutex& parseMutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    // errors == nullptr     stderr,  .
+    //  '    (AST::resolve)    .
+    inline std::unique_ptr<AST::Block> parse(const std::string& source, std::string* errors = nullptr) {
+        std::unique_ptr<AST::Block> root;
+        bool bind = false;
+        {
+            std::lock_guard<std::mutex> lock(parseMutex());
+            g_parseErrors = errors;
+            g_resolveNodes = 0;
+            yy_scan_bytes(source.data(), static_cast<int>(source.size()));
+            int res = yyparse();
+            yylex_destroy();
+            g_parseErrors = nullptr;
+            root.reset(g_root);
+            g_root = nullptr;
+            bind = g_resolveNodes != 0;
+            if (res != 0) root.reset();
+        }
+        if (!root || !bind) return root;
+        try { AST::resolve(*root); }
+        catch (const std::runtime_error& e) {
+            if (errors) *errors += std::string("Parse error: ") + e.what() + "\n";
+            else std::fprintf(stderr, "Parse error: %s\n", e.what());
+            return nullptr;
+        }
+        return root;
+    }
+
+    //  ,   (--bench   );  
+    inline std::size_t lex(const std::string& source) {
+        std::lock_guard<std::mutex> lock(parseMutex());
+        yy_scan_bytes(source.data(), static_cast<int>(source.size()));
+        std::size_t tokens = 0;
+        for (int t; (t = yylex()) != YYEOF; ++tokens)
+            if (t == IDENT) delete yylval.str;
+        yylex_destroy();
+        return tokens;
+    }
+
+    // TAC  ; steps   step    (VM)
+    inline TAC::Unit lower(const AST::Block* root, bool optimize, bool steps = false) {
+        TAC::Emitter em;
+        em.steps = steps;
+        em.gen(root);
+        if (optimize) TAC::Optimizer(em.unit).run();
+        return std::move(em.unit);
+    }
+
+    //   : AST  (,  )  VM,    ScopeCheck
+    struct Compiled {
+        std::unique_ptr<AST::Block> ast;
+
+        // false      ,  VM  aot  :  
+        bool staticScopes() const {
+            std::call_once(scopesOnce, [&]() { scopesOk = AST::ScopeCheck().run(*ast); });
+            return scopesOk;
+        }
+
+        const AST::Schedule& schedule() const {
+            std::call_once(scheduleOnce, [&]() { groups = AST::Schedule::build(*ast); });
+            return groups;
+        }
+
+        // steps:  step,   ;      
+        const VM::Program& vm(bool optimize, bool steps = false) const {
+            auto& s = slots[(optimize ? 1 : 0) + (steps ? 2 : 0)];
+            std::call_once(s.once, [&]() { s.code = VM::Program::compile(lower(ast.get(), optimize, steps)); });
+            return s.code;
+        }
+
+    private:
+        struct Slot {
+            std::once_flag once;
+            VM::Program code;
+        };
+        mutable Slot slots[4]; // [optimize + 2 * steps]
+        mutable std::once_flag scheduleOnce;
+        mutable AST::Schedule groups;
+        mutable std::once_flag scopesOnce;
+        mutable bool scopesOk = false;
+    };
+
+    //    ; ﳿ    
+    class Program {
+    public:
+        Program() = default;
+        explicit Program(std::shared_ptr<const Compiled> c) : p(std::move(c)) {}
+
+        // AST,    compile() (,  ASTCache)
+        static Program adopt(std::unique_ptr<AST::Block> root) {
+            if (!root) return Program();
+            auto c = std::make_shared<Compiled>();
+            c->ast = std::move(root);
+            return Program(std::move(c));
+        }
+
+        explicit operator bool() const { return p != nullptr; }
+        const AST::Block& ast() const { return *p->ast; }
+        const VM::Program& vm(bool optimize = false, bool steps = false) const { return p->vm(optimize, steps); }
+        const AST::Schedule& schedule() const { return p->schedule(); }
+        bool staticScopes() const { return p->staticScopes(); }
+        const std::shared_ptr<const Compiled>& shared() const { return p; }
+
+    private:
+        std::shared_ptr<const Compiled> p;
+    };
+
+    //  Program   ,   errors (  stderr)
+    inline Program compile(const std::string& source, std::string* errors = nullptr) {
+        return Program::adopt(parse(source, errors));
+    }
+
+    // Lanes    runRows:    ,    
+    enum class Engine { Tree, VM, Lanes };
+
+    struct RunOptions {
+        Engine engine = Engine::Tree;
+        bool optimize = false;          // Engine::VM:   TAC::Optimizer
+        std::ostream* out = nullptr;    // nullptr     Result::out
+        std::uint64_t maxSteps = 0;     //  , 0   
+        std::uint64_t maxOutput = 0;    //  , 0   
+        unsigned threads = 1;           // Engine::Tree:      , 0   
+        std::vector<std::pair<std::string, double>> inputs; //      
+        IO::Digits digits = IO::Digits::Twelve; //  print  
+        Trace::Sink* trace = nullptr;   // 䳿  ( Engine::Tree, )
+    };
+
+    struct Result {
+        int status = 0;     // 0  , 4     
+        std::string out;    // ,  RunOptions::out  
+        std::string error;  //  
+
+        bool ok() const { return status == 0; }
+    };
+
+    //         ;    ostream  exceptions(badbit)
+    struct LimitBuf : std::streambuf {
+        std::string* str;
+        std::ostream* to;
+        std::uint64_t limit, written = 0;
+        LimitBuf(std::string* s, std::ostream* target, std::uint64_t max) : str(s), to(target), limit(max) {}
+
+        int overflow(int c) override {
+            if (c == traits_type::eof()) return 0;
+            char ch = static_cast<char>(c);
+            xsputn(&ch, 1);
+            return c;
+        }
+        std::streamsize xsputn(const char* p, std::streamsize n) override {
+            auto k = static_cast<std::uint64_t>(n);
+            if (limit && written + k > limit) throw std::runtime_error("output limit exceeded");
+            written += k;
+            if (to) to->write(p, n);
+            else str->append(p, static_cast<std::size_t>(n));
+            return n;
+        }
+        int sync() override { return to && !to->flush() ? -1 : 0; }
+    };
+
+    template<class Ctx>
+    inline void execTree(const Program& program, const RunOptions& ro, std::ostream& out, Ctx& ctx) {
+        ctx.out = &out;
+        ctx.maxSteps = ro.maxSteps;
+        ctx.digits = ro.digits;
+        for (auto& in : ro.inputs) ctx.declare(in.first, in.second);
+        program.ast().exec(ctx);
+    }
+
+    //     Context (   VM),  Program   
+    inline Result run(const Program& program, const RunOptions& ro = RunOptions()) {
+        Result r;
+        LimitBuf buf(&r.out, ro.out, ro.maxOutput);
+        std::ostream limited(&buf);
+        limited.exceptions(std::ios::badbit);
+        //       
+        std::ostream& out = ro.out && !ro.maxOutput ? *ro.out : limited;
+        try {
+            if (ro.engine == Engine::VM) {
+                if (!ro.inputs.empty()) throw std::runtime_error("input variables need the tree engine");
+                if (ro.trace) throw std::runtime_error("tracing needs the tree engine");
+            }
+            //     :     VM  
+            if (ro.engine == Engine::VM && program.staticScopes())
+                VM::run(program.vm(ro.optimize, ro.maxSteps != 0), out, ro.maxSteps, ro.digits);
+            else if (ro.trace) {
+                AST::TraceContext ctx;
+                ctx.sink = ro.trace;
+                execTree(program, ro, out, ctx);
+            }
+            //       񳺿 ,     
+            else if (ro.threads != 1 && !ro.maxSteps && !ro.maxOutput && ro.inputs.empty() && program.schedule().groups.size() > 1)
+                AST::execParallel(program.ast(), program.schedule(), out, Pool::threads(ro.threads), ro.digits);
+            else {
+                AST::Context ctx;
+                execTree(program, ro, out, ctx);
+            }
+        }
+        catch (const std::exception& ex) {
+            r.status = 4;
+            r.error = ex.what();
+        }
+        return r;
+    }
+
+    //     ;       run().
+    // Engine::Lanes    ,      ro.threads .
+    inline std::vector<Result> runRows(const Program& program, const Lanes::Inputs& in, const RunOptions& ro = RunOptions()) {
+        const std::size_t rows = in.rows();
+        std::vector<Result> results(rows);
+        const unsigned threads = ro.trace ? 1 : Pool::threads(ro.threads); //  Sink     
+        if (ro.engine == Engine::Lanes && !ro.trace) {
+            try {
+                auto lanes = Lanes::run(program.ast(), in, ro.maxSteps, ro.maxOutput, ro.digits, threads);
+                for (std::size_t r = 0; r < rows; ++r) {
+                    results[r].out = std::move(lanes[r].out);
+                    results[r].error = std::move(lanes[r].error);
+                    results[r].status = results[r].error.empty() ? 0 : 4;
+                }
+                return results;
+            }
+            catch (const Lanes::Unsupported&) {
+                // ,    ,     
+            }
+        }
+        Pool::forEach(rows, threads, [&](std::size_t r) {
+            RunOptions one = ro;
+            one.engine = ro.engine == Engine::VM ? Engine::VM : Engine::Tree;
+            one.out = nullptr;
+            one.threads = 1;
+            for (std::size_t k = 0; k < in.names.size(); ++k) one.inputs.emplace_back(in.names[k], in.at(r, k));
+            results[r] = run(program, one);
+        });
+        return results;
+    }
+
+} // namespace Lab3
@@ -0,0 +1,377 @@
+// include/lanes.hpp
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include "ast.hpp"
+#include "pool.hpp"
+
+namespace Lanes {
+
+    //  :  ,     .
+    //        .
+    struct Inputs {
+        std::vector<std::string> names;
+        std::vector<std::vector<double>> columns;
+
+        std::size_t rows() const {
+            std::size_t n = 0;
+            for (auto& c : columns) if (c.size() > n) n = c.size();
+            return n;
+        }
+        double at(std::size_t row, std::size_t k) const {
+            auto& c = columns[k];
+            return c.size() == 1 ? c[0] : c[row];
+        }
+
+        // name=v1,v2,...
+        bool set(const std::string& spec, std::string& error) {
+            auto eq = spec.find('=');
+            if (eq == std::string::npos || eq == 0) { error = "expected name=value[,value...]: " + spec; return false; }
+            std::vector<double> values;
+            if (!numbers(spec.substr(eq + 1), ',', values, error)) return false;
+            return add(trim(spec.substr(0, eq)), std::move(values), error);
+        }
+
+        //    ,  ;   
+        bool csv(const std::string& text, std::string& error) {
+            std::vector<std::string> header;
+            std::vector<std::vector<double>> cols;
+            std::size_t line = 0;
+            for (std::size_t p = 0; p < text.size();) {
+                auto e = text.find('\n', p);
+                if (e == std::string::npos) e = text.size();
+                auto row = trim(text.substr(p, e - p));
+                p = e + 1;
+                ++line;
+                if (row.empty()) continue;
+                if (header.empty()) {
+                    for (std::size_t q = 0;;) {
+                        auto c = row.find(',', q);
+                        header.push_back(trim(row.substr(q, c == std::string::npos ? std::string::npos : c - q)));
+                        if (c == std::string::npos) break;
+                        q = c + 1;
+                    }
+                    cols.resize(header.size());
+                    continue;
+                }
+                std::vector<double> values;
+                if (!numbers(row, ',', values, error)) { error = "CSV line " + std::to_string(line) + ": " + error; return false; }
+                if (values.size() != header.size()) {
+                    error = "CSV line " + std::to_string(line) + ": expected " + std::to_string(header.size()) + " values";
+                    return false;
+                }
+                for (std::size_t k = 0; k < values.size(); ++k) cols[k].push_back(values[k]);
+            }
+            if (header.empty()) { error = "CSV has no header"; return false; }
+            for (std::size_t k = 0; k < header.size(); ++k)
+                if (!add(header[k], std::move(cols[k]), error)) return false;
+            return true;
+        }
+
+    private:
+        static std::string trim(const std::string& s) {
+            auto b = s.find_first_not_of(" \t\r");
+            if (b == std::string::npos) return std::string();
+            return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+        }
+
+        static bool numbers(const std::string& s, char sep, std::vector<double>& out, std::string& error) {
+            for (std::size_t q = 0;;) {
+                auto c = s.find(sep, q);
+                auto tok = trim(s.substr(q, c == std::string::npos ? std::string::npos : c - q));
+                char* end = nullptr;
+                double v = std::strtod(tok.c_str(), &end);
+                if (tok.empty() || *end) { error = "bad number '" + tok + "'"; return false; }
+                out.push_back(v);
+                if (c == std::string::npos) return true;
+                q = c + 1;
+            }
+        }
+
+        bool add(const std::string& name, std::vector<double> values, std::string& error) {
+            for (auto& n : names)
+                if (n == name) { error = "input set twice: " + name; return false; }
+            auto rows = this->rows();
+            if (values.empty() || (values.size() != 1 && rows > 1 && values.size() != rows)) {
+                error = "input " + name + " has " + std::to_string(values.size()) + " values, others have " + std::to_string(rows);
+                return false;
+            }
+            for (auto& c : columns)
+                if (c.size() != 1 && values.size() > 1 && c.size() != values.size()) {
+                    error = "input " + name + " has " + std::to_string(values.size()) + " values, others have " + std::to_string(c.size());
+                    return false;
+                }
+            names.push_back(name);
+            columns.push_back(std::move(values));
+            return true;
+        }
+    };
+
+    // ,    :    
+    struct Unsupported : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    //        Block::exec
+    struct Row {
+        std::string out;
+        std::string error; //   
+    };
+
+    using Values = std::vector<double>;
+    using Mask = std::vector<std::uint8_t>;
+
+    //       ();      .
+    //      ,   .
+    class Machine {
+    public:
+        Machine(std::size_t lanes, std::uint64_t maxSteps, std::uint64_t maxOutput, IO::Digits digits = IO::Digits::Twelve)
+            : n(lanes), maxSteps(maxSteps), maxOutput(maxOutput), digits(digits), live(lanes, 1), steps(lanes, 0), rows(lanes) {
+            scopes.emplace_back();
+        }
+
+        //      ,  Context::declare  
+        void input(const std::string& name, Values v) {
+            auto& var = scopes.back()[name];
+            var.v = std::move(v);
+            var.declared.assign(n, 1);
+        }
+
+        std::vector<Row> run(const AST::Block& root) {
+            exec(&root, live);
+            return std::move(rows);
+        }
+
+    private:
+        struct Var {
+            Values v;
+            Mask declared;
+        };
+        using Scope = std::unordered_map<std::string, Var>;
+
+        std::size_t n;
+        std::uint64_t maxSteps, maxOutput;
+        IO::Digits digits;
+        Mask live;
+        std::vector<std::uint64_t> steps;
+        std::vector<Row> rows;
+        std::vector<Scope> scopes;
+        //   :    ,    Machine.
+        // deque:     ,      
+        std::deque<Values> scratch;
+        std::deque<Mask> masks;
+        std::vector<Var*> found; // chain
+
+        double* slot(std::size_t depth) {
+            while (scratch.size() <= depth) scratch.emplace_back(n);
+            return scratch[depth].data();
+        }
+
+        Mask& maskAt(std::size_t depth) {
+            while (masks.size() <= depth) masks.emplace_back(n);
+            return masks[depth];
+        }
+
+        void fail(std::size_t i, const std::string& what) {
+            live[i] = 0;
+            rows[i].error = what;
+        }
+
+        bool active(const Mask& m, std::size_t i) const { return m[i] && live[i]; }
+
+        bool any(const Mask& m) const {
+            for (std::size_t i = 0; i < n; ++i) if (m[i] && live[i]) return true;
+            return false;
+        }
+
+        //    '   ;   ,  .
+        // ĳ   chain
+        const std::vector<Var*>& chain(const std::string& name) {
+            found.clear();
+            for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+                auto f = it->find(name);
+                if (f != it->end()) found.push_back(&f->second);
+            }
+            return found;
+        }
+
+        //     (Ref::Global):   
+        const std::vector<Var*>& chain(const AST::Ident* id) {
+            if (id->ref != AST::Ref::Global) return chain(id->name);
+            found.clear();
+            auto f = scopes.front().find(id->name);
+            if (f != scopes.front().end()) found.push_back(&f->second);
+            return found;
+        }
+
+        static Var* pick(const std::vector<Var*>& c, std::size_t i) {
+            for (Var* v : c) if (v->declared[i]) return v;
+            return nullptr;
+        }
+
+        //     slot(depth);    
+        const double* eval(const AST::Expr* e, const Mask& m, std::size_t depth = 0) {
+            using AST::BinOp;
+            double* x = slot(depth);
+            if (auto num = dynamic_cast<const AST::Number*>(e)) {
+                const double v = num->value;
+                for (std::size_t i = 0; i < n; ++i) x[i] = v;
+                return x;
+            }
+            if (auto id = dynamic_cast<const AST::Ident*>(e)) {
+                auto& c = chain(id);
+                for (std::size_t i = 0; i < n; ++i) {
+                    x[i] = 0.0;
+                    if (!active(m, i)) continue;
+                    if (Var* v = pick(c, i)) x[i] = v->v[i];
+                    else fail(i, "undefined variable: " + id->name);
+                }
+                return x;
+            }
+            if (auto u = dynamic_cast<const AST::Unary*>(e)) {
+                eval(u->E.get(), m, depth);
+                if (u->op == AST::UnOp::Neg) for (std::size_t i = 0; i < n; ++i) x[i] = -x[i];
+                else for (std::size_t i = 0; i < n; ++i) x[i] = x[i] == 0.0 ? 1.0 : 0.0;
+                return x;
+            }
+            auto b = dynamic_cast<const AST::Binary*>(e);
+            if (!b) throw Unsupported("unsupported expression");
+
+            eval(b->L.get(), m, depth);
+            if (b->op == BinOp::And || b->op == BinOp::Or) {
+                //     ,     
+                const bool isAnd = b->op == BinOp::And;
+                Mask& rm = maskAt(depth);
+                for (std::size_t i = 0; i < n; ++i) rm[i] = active(m, i) && ((x[i] != 0.0) == isAnd);
+                for (std::size_t i = 0; i < n; ++i) x[i] = isAnd ? 0.0 : 1.0;
+                if (any(rm)) {
+                    const double* c = eval(b->R.get(), rm, depth + 1);
+                    for (std::size_t i = 0; i < n; ++i) if (rm[i]) x[i] = c[i] != 0.0 ? 1.0 : 0.0;
+                }
+                return x;
+            }
+
+            const double* y = eval(b->R.get(), m, depth + 1);
+            switch (b->op) {
+            case BinOp::Add: for (std::size_t i = 0; i < n; ++i) x[i] += y[i]; break;
+            case BinOp::Sub: for (std::size_t i = 0; i < n; ++i) x[i] -= y[i]; break;
+            case BinOp::Mul: for (std::size_t i = 0; i < n; ++i) x[i] *= y[i]; break;
+            case BinOp::Div:
+                for (std::size_t i = 0; i < n; ++i)
+                    if (y[i] == 0.0 && active(m, i)) fail(i, "division by zero");
+                for (std::size_t i = 0; i < n; ++i) x[i] /= y[i];
+                break;
+            case BinOp::Mod: for (std::size_t i = 0; i < n; ++i) x[i] = std::fmod(x[i], y[i]); break;
+            case BinOp::LT: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] < y[i] ? 1.0 : 0.0; break;
+            case BinOp::LE: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] <= y[i] ? 1.0 : 0.0; break;
+            case BinOp::GT: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] > y[i] ? 1.0 : 0.0; break;
+            case BinOp::GE: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] >= y[i] ? 1.0 : 0.0; break;
+            case BinOp::EQ: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] == y[i] ? 1.0 : 0.0; break;
+            case BinOp::NE: for (std::size_t i = 0; i < n; ++i) x[i] = x[i] != y[i] ? 1.0 : 0.0; break;
+            default: for (std::size_t i = 0; i < n; ++i) x[i] = 0.0; break;
+            }
+            return x;
+        }
+
+        //     ,   LimitBuf: ,   ,  
+        void emit(std::size_t i, const char* p, std::size_t len) {
+            auto& s = rows[i].out;
+            if (maxOutput && s.size() + len > maxOutput) { fail(i, "output limit exceeded"); return; }
+            s.append(p, len);
+        }
+
+        void exec(const AST::Stmt* s, const Mask& m) {
+            if (auto bl = dynamic_cast<const AST::Block*>(s)) {
+                if (bl->createScope) scopes.emplace_back();
+                for (auto& it : bl->items) {
+                    if (!any(m)) break;
+                    exec(it.get(), m);
+                }
+                if (bl->createScope) scopes.pop_back();
+            }
+            else if (auto vd = dynamic_cast<const AST::VarDecl*>(s)) {
+                const double* v = vd->init ? eval(vd->init.get(), m) : nullptr;
+                auto& var = scopes.back()[vd->name];
+                if (var.declared.empty()) { var.v.assign(n, 0.0); var.declared.assign(n, 0); }
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (!active(m, i)) continue;
+                    if (var.declared[i]) fail(i, "redeclaration in the same scope: " + vd->name);
+                    else { var.declared[i] = 1; var.v[i] = v ? v[i] : 0.0; }
+                }
+            }
+            else if (auto as = dynamic_cast<const AST::Assign*>(s)) {
+                const double* v = eval(as->value.get(), m);
+                auto& c = chain(as->name);
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (!active(m, i)) continue;
+                    if (Var* var = pick(c, i)) var->v[i] = v[i];
+                    else fail(i, "assignment to undeclared variable: " + as->name);
+                }
+            }
+            else if (auto pr = dynamic_cast<const AST::Print*>(s)) {
+                const double* v = eval(pr->what.get(), m);
+                char tmp[IO::numberChars + 1];
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (!active(m, i)) continue;
+                    //   ,    Print::exec
+                    std::size_t len = IO::formatNumber(tmp, v[i], digits);
+                    tmp[len++] = '\n';
+                    emit(i, tmp, len);
+                }
+            }
+            else if (auto c = dynamic_cast<const AST::If*>(s)) {
+                const double* v = eval(c->cond.get(), m);
+                Mask t(n, 0), f(n, 0);
+                for (std::size_t i = 0; i < n; ++i) {
+                    t[i] = active(m, i) && v[i] != 0.0;
+                    f[i] = active(m, i) && v[i] == 0.0;
+                }
+                if (any(t)) exec(c->thenS.get(), t);
+                if (c->elseS && any(f)) exec(c->elseS.get(), f);
+            }
+            else if (auto w = dynamic_cast<const AST::While*>(s)) {
+                Mask cur = m;
+                for (;;) {
+                    const double* v = eval(w->cond.get(), cur);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        cur[i] = active(cur, i) && v[i] != 0.0;
+                        if (cur[i] && maxSteps && ++steps[i] > maxSteps) fail(i, "step limit exceeded");
+                    }
+                    if (!any(cur)) break;
+                    exec(w->body.get(), cur);
+                }
+            }
+            else if (auto es = dynamic_cast<const AST::ExprStmt*>(s)) eval(es->expr.get(), m);
+            else if (dynamic_cast<const AST::Function*>(s)) {} //   Unsupported  eval
+            else throw Unsupported("unsupported statement");
+        }
+    };
+
+    //    chunk ,    
+    inline std::vector<Row> run(const AST::Block& root, const Inputs& in, std::uint64_t maxSteps = 0,
+        std::uint64_t maxOutput = 0, IO::Digits digits = IO::Digits::Twelve, unsigned threads = 1, std::size_t chunk = 512) {
+        const std::size_t total = in.rows();
+        std::vector<Row> rows(total);
+        const std::size_t parts = (total + chunk - 1) / chunk;
+        Pool::forEach(parts, threads, [&](std::size_t p) {
+            const std::size_t begin = p * chunk, lanes = std::min(chunk, total - begin);
+            Machine vm(lanes, maxSteps, maxOutput, digits);
+            for (std::size_t k = 0; k < in.names.size(); ++k) {
+                Values v(lanes);
+                for (std::size_t i = 0; i < lanes; ++i) v[i] = in.at(begin + i, k);
+                vm.input(in.names[k], std::move(v));
+            }
+            auto part = vm.run(root);
+            for (std::size_t i = 0; i < lanes; ++i) rows[begin + i] = std::move(part[i]);
+        });
+        return rows;
+    }
+
+} // namespace Lanes
@@ -0,0 +1,178 @@
+// include/memo.hpp
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <ostream>
+#include <streambuf>
+#include <filesystem>
+#include <system_error>
+#include "astcache.hpp"
+#include "numfmt.hpp"
+
+namespace Memo {
+
+    //    ,        .  
+    // (--memo)   stdout       ASTCache (*.out),
+    //       LRU-.
+    constexpr std::uint32_t kVersion = 2;
+    constexpr char kMagic[4] = { 'L', '3', 'R', 'C' };
+
+    //     :      
+    constexpr const char* kBuild = __DATE__ " " __TIME__;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t code;
+        std::uint32_t pad;
+        std::uint64_t outBytes;
+        std::uint64_t errBytes;
+        std::uint64_t srcBytes; // Key::srcBytes
+        std::uint64_t check;    // Key::check
+    };
+
+    static_assert(sizeof(Header) == 48, "memo layout");
+
+    struct Entry {
+        int code = 0;
+        std::string out; // stdout 
+        std::string err; //    (    )
+    };
+
+    // ,   :   ,      
+    enum class Engine : std::uint32_t { Tree, VM, Aot };
+
+    // hash  ' ; check (    )    
+    //      ,   hash  ,    
+    struct Key {
+        std::uint64_t hash = 0;
+        std::uint64_t check = 0;
+        std::uint64_t srcBytes = 0;
+    };
+
+    // ,   ,    :  , ,   --tac-opt
+    inline Key key(const std::string& source, IO::Digits digits, std::uint64_t maxSteps, std::uint64_t maxOutput,
+        Engine engine, bool optimize) {
+        Key k;
+        k.hash = 1469598103934665603ull; // FNV-1a
+        k.check = 0x9e3779b97f4a7c15ull; //   xorshift,   FNV
+        k.srcBytes = source.size();
+        auto mix = [&](const void* p, std::size_t n) {
+            auto b = static_cast<const unsigned char*>(p);
+            for (std::size_t i = 0; i < n; ++i) {
+                k.hash ^= b[i]; k.hash *= 1099511628211ull;
+                k.check = (k.check + b[i]) * 0xff51afd7ed558ccdull; k.check ^= k.check >> 32;
+            }
+        };
+        mix(source.data(), source.size());
+        mix(kBuild, std::strlen(kBuild));
+        std::uint64_t tail[6] = { kVersion, static_cast<std::uint64_t>(digits), maxSteps, maxOutput,
+            static_cast<std::uint64_t>(engine), optimize ? 1u : 0u };
+        mix(tail, sizeof tail);
+        return k;
+    }
+
+    //            .
+    //   max  :     (over).
+    struct Tee : std::streambuf {
+        std::ostream* to;
+        std::size_t max;
+        std::string text;
+        bool over = false;
+        Tee(std::ostream* target, std::size_t limit) : to(target), max(limit) {}
+
+        int overflow(int c) override {
+            if (c == traits_type::eof()) return 0;
+            char ch = static_cast<char>(c);
+            xsputn(&ch, 1);
+            return c;
+        }
+        std::streamsize xsputn(const char* p, std::streamsize n) override {
+            auto k = static_cast<std::size_t>(n);
+            if (!over && text.size() + k <= max) text.append(p, k);
+            else { over = true; std::string().swap(text); }
+            to->write(p, n);
+            return n;
+        }
+        int sync() override { return to->flush() ? 0 : -1; }
+    };
+
+    struct Store {
+        const ASTCache::Store& cache; // , , 
+
+        std::filesystem::path pathFor(const Key& key) const {
+            char buf[32];
+            std::snprintf(buf, sizeof buf, "%016llx.out", static_cast<unsigned long long>(key.hash));
+            return cache.dir / buf;
+        }
+
+        //       ,    
+        std::size_t entryMax() const { return static_cast<std::size_t>(cache.maxBytes / 4); }
+
+        //       
+        bool load(const Key& key, Entry& e) const {
+            auto p = pathFor(key);
+            FILE* f = nullptr;
+#ifdef _MSC_VER
+            if (fopen_s(&f, p.string().c_str(), "rb") != 0) f = nullptr;
+#else
+            f = std::fopen(p.c_str(), "rb");
+#endif
+            if (!f) return false;
+            Header h;
+            bool ok = std::fread(&h, sizeof h, 1, f) == 1 && std::memcmp(h.magic, kMagic, 4) == 0 &&
+                h.version == kVersion && h.srcBytes == key.srcBytes && h.check == key.check &&
+                h.outBytes <= entryMax() && h.errBytes <= entryMax();
+            if (ok) {
+                e.code = h.code;
+                e.out.resize(static_cast<std::size_t>(h.outBytes));
+                e.err.resize(static_cast<std::size_t>(h.errBytes));
+                ok = std::fread(&e.out[0], 1, e.out.size(), f) == e.out.size() &&
+                    std::fread(&e.err[0], 1, e.err.size(), f) == e.err.size() &&
+                    std::fgetc(f) == EOF;
+            }
+            std::fclose(f);
+            if (ok) {
+                std::error_code ec; //  LRU-
+                std::filesystem::last_write_time(p, std::filesystem::file_time_type::clock::now(), ec);
+            }
+            return ok;
+        }
+
+        void save(const Key& key, const Entry& e) const {
+            if (e.out.size() + e.err.size() > entryMax()) return;
+            std::error_code ec;
+            std::filesystem::create_directories(cache.dir, ec);
+            Header h{};
+            std::memcpy(h.magic, kMagic, 4);
+            h.version = kVersion;
+            h.code = e.code;
+            h.outBytes = e.out.size();
+            h.errBytes = e.err.size();
+            h.srcBytes = key.srcBytes;
+            h.check = key.check;
+            auto p = pathFor(key);
+            auto tmp = p; tmp += ASTCache::tmpTag() + ".tmp";
+            {
+                FILE* f = nullptr;
+#ifdef _MSC_VER
+                if (fopen_s(&f, tmp.string().c_str(), "wb") != 0) f = nullptr;
+#else
+                f = std::fopen(tmp.c_str(), "wb");
+#endif
+                if (!f) return;
+                bool ok = std::fwrite(&h, sizeof h, 1, f) == 1 &&
+                    std::fwrite(e.out.data(), 1, e.out.size(), f) == e.out.size() &&
+                    std::fwrite(e.err.data(), 1, e.err.size(), f) == e.err.size();
+                ok = std::fclose(f) == 0 && ok;
+                if (!ok) { std::filesystem::remove(tmp, ec); return; }
+            }
+            std::filesystem::rename(tmp, p, ec); //    
+            if (ec) std::filesystem::remove(tmp, ec);
+            if (cache.autoEvict) cache.evict();
+        }
+    };
+
+} // namespace Memo
@@ -0,0 +1,206 @@
+// include/memstats.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <string>
+#include "ast.hpp"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+//  '  --mem-stats:  operator new/delete (  main.cpp)
+//  allocated/freed.        .
+//    ,    :     
+// (AST  ),           .
+namespace Mem {
+
+    enum class Phase : unsigned char { Other, Parse, Cache, Dot, Tac, Exec, Count };
+
+    inline const char* phaseName(Phase p) {
+        switch (p) {
+        case Phase::Parse: return "parse";
+        case Phase::Cache: return "cache";
+        case Phase::Dot: return "dot";
+        case Phase::Tac: return "tac";
+        case Phase::Exec: return "exec";
+        default: return "other";
+        }
+    }
+
+    struct Counters {
+        std::atomic<std::uint64_t> allocs{ 0 }, bytes{ 0 };
+        std::atomic<std::int64_t> peak{ 0 }; //    ,   
+    };
+
+    struct State {
+        std::atomic<bool> enabled{ false };
+        std::atomic<std::int64_t> live{ 0 }; //   ;     
+        std::atomic<std::uint64_t> frees{ 0 }, freed{ 0 }; //   
+        Counters phases[static_cast<int>(Phase::Count)];
+    };
+
+    inline State& state() {
+        static State s; //  :   operator new
+        return s;
+    }
+
+    inline Phase& current() {
+        thread_local Phase p = Phase::Other;
+        return p;
+    }
+
+    //      (  )
+    struct Scope {
+        Phase saved;
+        explicit Scope(Phase p) : saved(current()) { current() = p; }
+        ~Scope() { current() = saved; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    //   :     ,   
+    inline std::size_t usable(void* p) {
+#if defined(_WIN32)
+        return _msize(p);
+#elif defined(__APPLE__)
+        return malloc_size(p);
+#else
+        return malloc_usable_size(p);
+#endif
+    }
+
+    inline void allocated(void* p) {
+        auto& s = state();
+        if (!p || !s.enabled.load(std::memory_order_relaxed)) return;
+        auto n = usable(p);
+        auto& c = s.phases[static_cast<int>(current())];
+        c.allocs.fetch_add(1, std::memory_order_relaxed);
+        c.bytes.fetch_add(n, std::memory_order_relaxed);
+        auto now = s.live.fetch_add(static_cast<std::int64_t>(n), std::memory_order_relaxed) + static_cast<std::int64_t>(n);
+        auto peak = c.peak.load(std::memory_order_relaxed);
+        while (now > peak && !c.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+    }
+
+    inline void freed(void* p) {
+        auto& s = state();
+        if (!p || !s.enabled.load(std::memory_order_relaxed)) return;
+        auto n = usable(p);
+        s.frees.fetch_add(1, std::memory_order_relaxed);
+        s.freed.fetch_add(n, std::memory_order_relaxed);
+        s.live.fetch_sub(static_cast<std::int64_t>(n), std::memory_order_relaxed);
+    }
+
+    inline void enable() { state().enabled.store(true, std::memory_order_relaxed); }
+
+    inline void report(std::ostream& out) {
+        auto& s = state();
+        char line[160];
+        std::snprintf(line, sizeof line, "mem: %-6s %10s %14s %14s  (frees: process total below, not per phase)\n",
+            "phase", "allocs", "bytes", "peak-live");
+        out << line;
+        for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+            auto& c = s.phases[i];
+            if (!c.allocs.load()) continue;
+            std::snprintf(line, sizeof line, "mem: %-6s %10llu %14llu %14lld\n",
+                phaseName(static_cast<Phase>(i)),
+                static_cast<unsigned long long>(c.allocs.load()), static_cast<unsigned long long>(c.bytes.load()),
+                static_cast<long long>(c.peak.load()));
+            out << line;
+        }
+        std::snprintf(line, sizeof line, "mem: frees  %10llu %14llu  (all phases)\n",
+            static_cast<unsigned long long>(s.frees.load()), static_cast<unsigned long long>(s.freed.load()));
+        out << line;
+        std::snprintf(line, sizeof line, "mem: live at exit %lld bytes\n", static_cast<long long>(s.live.load()));
+        out << line;
+    }
+
+    //   :   ,       
+    struct AstFootprint {
+        struct Kind {
+            std::uint64_t count = 0, bytes = 0;
+        };
+        static constexpr int kindCount = 17;
+        Kind kinds[kindCount];
+
+        static const char* name(int k) {
+            static const char* names[] = { "Block", "VarDecl", "Assign", "Print", "If", "While",
+                "Number", "Ident", "Binary", "Unary", "Function", "Return", "ExprStmt", "Call",
+                "ArrayDecl", "IndexAssign", "Index" };
+            return names[k];
+        }
+
+        //   SSO
+        static std::uint64_t heap(const std::string& s) {
+            return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+        }
+
+        void add(int k, std::uint64_t bytes) { ++kinds[k].count; kinds[k].bytes += bytes; }
+
+        void expr(const AST::Expr* e) {
+            if (!e) return;
+            if (dynamic_cast<const AST::Number*>(e)) add(6, sizeof(AST::Number));
+            else if (auto id = dynamic_cast<const AST::Ident*>(e)) add(7, sizeof(AST::Ident) + heap(id->name));
+            else if (auto b = dynamic_cast<const AST::Binary*>(e)) { add(8, sizeof(AST::Binary)); expr(b->L.get()); expr(b->R.get()); }
+            else if (auto u = dynamic_cast<const AST::Unary*>(e)) { add(9, sizeof(AST::Unary)); expr(u->E.get()); }
+            else if (auto c = dynamic_cast<const AST::Call*>(e)) {
+                add(13, sizeof(AST::Call) + heap(c->name) + c->args.capacity() * sizeof(c->args[0]));
+                for (auto& a : c->args) expr(a.get());
+            }
+            else if (auto ix = dynamic_cast<const AST::Index*>(e)) { add(16, sizeof(AST::Index) + heap(ix->name)); expr(ix->index.get()); }
+        }
+
+        void stmt(const AST::Stmt* s) {
+            if (!s) return;
+            if (auto bl = dynamic_cast<const AST::Block*>(s)) {
+                add(0, sizeof(AST::Block) + bl->items.capacity() * sizeof(bl->items[0]));
+                for (auto& it : bl->items) stmt(it.get());
+            }
+            else if (auto vd = dynamic_cast<const AST::VarDecl*>(s)) { add(1, sizeof(AST::VarDecl) + heap(vd->name)); expr(vd->init.get()); }
+            else if (auto as = dynamic_cast<const AST::Assign*>(s)) { add(2, sizeof(AST::Assign) + heap(as->name)); expr(as->value.get()); }
+            else if (auto pr = dynamic_cast<const AST::Print*>(s)) { add(3, sizeof(AST::Print)); expr(pr->what.get()); }
+            else if (auto i = dynamic_cast<const AST::If*>(s)) { add(4, sizeof(AST::If)); expr(i->cond.get()); stmt(i->thenS.get()); stmt(i->elseS.get()); }
+            else if (auto w = dynamic_cast<const AST::While*>(s)) { add(5, sizeof(AST::While)); expr(w->cond.get()); stmt(w->body.get()); }
+            else if (auto f = dynamic_cast<const AST::Function*>(s)) {
+                std::uint64_t b = sizeof(AST::Function) + heap(f->name) + f->params.capacity() * sizeof(f->params[0]);
+                for (auto& p : f->params) b += heap(p.second);
+                add(10, b);
+                stmt(f->body.get());
+            }
+            else if (auto r = dynamic_cast<const AST::Return*>(s)) { add(11, sizeof(AST::Return)); expr(r->value.get()); }
+            else if (auto es = dynamic_cast<const AST::ExprStmt*>(s)) { add(12, sizeof(AST::ExprStmt)); expr(es->expr.get()); }
+            else if (auto ad = dynamic_cast<const AST::ArrayDecl*>(s)) add(14, sizeof(AST::ArrayDecl) + heap(ad->name));
+            else if (auto ia = dynamic_cast<const AST::IndexAssign*>(s)) {
+                add(15, sizeof(AST::IndexAssign) + heap(ia->name));
+                expr(ia->index.get());
+                expr(ia->value.get());
+            }
+        }
+
+        void write(std::ostream& out) const {
+            std::uint64_t count = 0, bytes = 0;
+            char line[120];
+            for (int k = 0; k < kindCount; ++k) {
+                if (!kinds[k].count) continue;
+                std::snprintf(line, sizeof line, "mem: ast %-11s %10llu nodes %12llu bytes\n", name(k),
+                    static_cast<unsigned long long>(kinds[k].count), static_cast<unsigned long long>(kinds[k].bytes));
+                out << line;
+                count += kinds[k].count;
+                bytes += kinds[k].bytes;
+            }
+            std::snprintf(line, sizeof line, "mem: ast %-11s %10llu nodes %12llu bytes\n", "total",
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(bytes));
+            out << line;
+        }
+    };
+
+} // namespace Mem
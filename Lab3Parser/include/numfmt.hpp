@@ -0,0 +1,36 @@
+// include/numfmt.hpp
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace IO {
+
+    // Twelve   std::setprecision(12) (%.12g), Shortest   ,
+    //   strtod    double
+    enum class Digits : unsigned char { Twelve, Shortest };
+
+    //   - double   
+    constexpr std::size_t numberChars = 32;
+
+    //      ;   ( '\0')
+    inline std::size_t formatNumber(char* buf, double v, Digits d = Digits::Twelve) {
+        auto r = d == Digits::Twelve
+            ? std::to_chars(buf, buf + numberChars, v, std::chars_format::general, 12)
+            : std::to_chars(buf, buf + numberChars, v);
+        return r.ec == std::errc() ? static_cast<std::size_t>(r.ptr - buf) : 0;
+    }
+
+    inline void appendNumber(std::string& s, double v, Digits d = Digits::Twelve) {
+        char tmp[numberChars];
+        s.append(tmp, formatNumber(tmp, v, d));
+    }
+
+    inline std::string numberText(double v, Digits d = Digits::Twelve) {
+        std::string s;
+        appendNumber(s, v, d);
+        return s;
+    }
+
+} // namespace IO
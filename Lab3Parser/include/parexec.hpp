@@ -0,0 +1,169 @@
+// include/parexec.hpp
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ast.hpp"
+#include "pool.hpp"
+
+namespace AST {
+
+    // ,     ,     If/While/Block.
+    //       :  ,  .
+    struct Access {
+        std::vector<const std::string*> reads, writes;
+        bool opaque = false; //     
+
+        void expr(const Expr* e) {
+            if (!e) return;
+            if (dynamic_cast<const Number*>(e)) return;
+            if (auto id = dynamic_cast<const Ident*>(e)) reads.push_back(&id->name);
+            else if (auto u = dynamic_cast<const Unary*>(e)) expr(u->E.get());
+            else if (auto b = dynamic_cast<const Binary*>(e)) { expr(b->L.get()); expr(b->R.get()); }
+            else if (auto ix = dynamic_cast<const Index*>(e)) { reads.push_back(&ix->name); expr(ix->index.get()); }
+            else opaque = true;
+        }
+
+        void stmt(const Stmt* s) {
+            if (!s) return;
+            if (auto bl = dynamic_cast<const Block*>(s)) { for (auto& it : bl->items) stmt(it.get()); }
+            else if (auto vd = dynamic_cast<const VarDecl*>(s)) { expr(vd->init.get()); writes.push_back(&vd->name); }
+            else if (auto as = dynamic_cast<const Assign*>(s)) { expr(as->value.get()); writes.push_back(&as->name); }
+            else if (auto pr = dynamic_cast<const Print*>(s)) expr(pr->what.get());
+            else if (auto i = dynamic_cast<const If*>(s)) { expr(i->cond.get()); stmt(i->thenS.get()); stmt(i->elseS.get()); }
+            else if (auto w = dynamic_cast<const While*>(s)) { expr(w->cond.get()); stmt(w->body.get()); }
+            else if (auto es = dynamic_cast<const ExprStmt*>(s)) expr(es->expr.get());
+            else if (auto ad = dynamic_cast<const ArrayDecl*>(s)) writes.push_back(&ad->name);
+            else if (auto ia = dynamic_cast<const IndexAssign*>(s)) {
+                expr(ia->index.get());
+                expr(ia->value.get());
+                writes.push_back(&ia->name);
+            }
+            else if (dynamic_cast<const Function*>(s)) {} // ;   opaque
+            else opaque = true;
+        }
+    };
+
+    //    ,     ,   .
+    //    ; print  '     .
+    struct Schedule {
+        std::vector<std::vector<std::uint32_t>> groups;
+
+        static Schedule build(const Block& root) {
+            const auto n = static_cast<std::uint32_t>(root.items.size());
+            std::vector<Access> acc(n);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                acc[i].stmt(root.items[i].get());
+                if (acc[i].opaque) return serial(n);
+            }
+
+            std::vector<std::uint32_t> parent(n);
+            std::iota(parent.begin(), parent.end(), 0u);
+            auto find = [&](std::uint32_t x) {
+                while (parent[x] != x) x = parent[x] = parent[parent[x]];
+                return x;
+            };
+
+            //  ,   :     
+            std::unordered_map<std::string, std::uint32_t> first; // ' ->  
+            for (std::uint32_t i = 0; i < n; ++i)
+                for (auto* w : acc[i].writes) first.emplace(*w, none);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                auto link = [&](const std::string* name) {
+                    auto f = first.find(*name);
+                    if (f == first.end()) return;
+                    if (f->second == none) f->second = i;
+                    else parent[find(i)] = find(f->second);
+                };
+                for (auto* r : acc[i].reads) link(r);
+                for (auto* w : acc[i].writes) link(w);
+            }
+
+            Schedule s;
+            std::vector<std::uint32_t> slot(n, none);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                auto r = find(i);
+                if (slot[r] == none) { slot[r] = static_cast<std::uint32_t>(s.groups.size()); s.groups.emplace_back(); }
+                s.groups[slot[r]].push_back(i);
+            }
+            return s;
+        }
+
+        static Schedule serial(std::uint32_t n) {
+            Schedule s;
+            s.groups.emplace_back(n);
+            std::iota(s.groups[0].begin(), s.groups[0].end(), 0u);
+            return s;
+        }
+
+    private:
+        static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+    };
+
+    //    ,    Context  .     
+    //    Block::exec:    ,  ,    .
+    inline void execParallel(const Block& root, const Schedule& s, std::ostream& out, unsigned threads,
+        IO::Digits digits = IO::Digits::Twelve) {
+        const std::size_t n = root.items.size(), g = s.groups.size();
+        std::vector<std::size_t> ends(n, 0);      //      
+        std::vector<std::uint32_t> owner(n, 0);
+        std::vector<std::string> text(g);
+        std::vector<std::atomic<bool>> stop(g);
+        std::vector<std::size_t> current(g, 0);
+        std::mutex m;
+        std::size_t failedAt = n;
+        std::exception_ptr error;
+
+        for (std::uint32_t k = 0; k < g; ++k)
+            for (auto i : s.groups[k]) owner[i] = k;
+
+        Pool::forEach(g, threads, [&](std::size_t k) {
+            std::ostringstream os;
+            Context ctx;
+            ctx.out = &os;
+            ctx.cancel = &stop[k];
+            ctx.digits = digits;
+            if (root.createScope) ctx.push();
+            for (auto i : s.groups[k]) {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (i > failedAt) break; //      
+                    current[k] = i;
+                }
+                try {
+                    root.items[i]->exec(ctx);
+                    ends[i] = static_cast<std::size_t>(os.tellp());
+                }
+                catch (...) {
+                    ends[i] = static_cast<std::size_t>(os.tellp());
+                    std::lock_guard<std::mutex> lock(m);
+                    if (i < failedAt) {
+                        failedAt = i;
+                        error = std::current_exception();
+                        for (std::size_t o = 0; o < g; ++o)
+                            if (current[o] > i) stop[o].store(true, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+            }
+            text[k] = os.str();
+        });
+
+        std::vector<std::size_t> pos(g, 0);
+        for (std::size_t i = 0; i < n && i <= failedAt; ++i) {
+            auto k = owner[i];
+            out.write(text[k].data() + pos[k], static_cast<std::streamsize>(ends[i] - pos[k]));
+            pos[k] = ends[i];
+        }
+        out.flush();
+        if (error) std::rethrow_exception(error);
+    }
+
+} // namespace AST
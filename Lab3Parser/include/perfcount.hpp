@@ -0,0 +1,134 @@
+// include/perfcount.hpp
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//    --bench (perf_event_open).      ,
+// , perf_event_paranoid    .
+namespace Perf {
+
+    enum Event { Cycles, Instructions, BranchMisses, L1Misses, LLCMisses, EventCount };
+
+    inline const char* eventName(int e) {
+        static const char* names[] = { "cycles", "instructions", "branch-misses", "l1d-misses", "llc-misses" };
+        return names[e];
+    }
+
+    struct Sample {
+        double ms = 0.0;
+        bool have[EventCount] = {};
+        std::uint64_t values[EventCount] = {};
+
+        bool counted() const {
+            for (bool h : have) if (h) return true;
+            return false;
+        }
+    };
+
+    //   ,  :  ( L1  )
+    //   .      .
+    class Counters {
+    public:
+        std::string why; //   
+
+        Counters() {
+            for (auto& fd : fds) fd = -1;
+#if defined(__linux__)
+            int opened = 0, err = 0;
+            for (int e = 0; e < EventCount; ++e) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof attr);
+                attr.size = sizeof attr;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                config(e, attr);
+                fds[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fds[e] >= 0) ++opened;
+                else err = errno;
+            }
+            if (!opened) why = std::string("perf_event_open: ") + std::strerror(err);
+#else
+            why = "perf_event_open is Linux-only";
+#endif
+        }
+
+        ~Counters() {
+#if defined(__linux__)
+            for (int fd : fds) if (fd >= 0) close(fd);
+#endif
+        }
+
+        Counters(const Counters&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        bool available() const { return why.empty(); }
+
+        //    f();  Linux      ms
+        template<class F>
+        Sample measure(F&& f) {
+            Sample s;
+            control(PERF_RESET);
+            control(PERF_ENABLE);
+            auto t0 = std::chrono::steady_clock::now();
+            f();
+            auto t1 = std::chrono::steady_clock::now();
+            control(PERF_DISABLE);
+            s.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            collect(s);
+            return s;
+        }
+
+    private:
+        int fds[EventCount];
+
+#if defined(__linux__)
+        enum Control { PERF_RESET = PERF_EVENT_IOC_RESET, PERF_ENABLE = PERF_EVENT_IOC_ENABLE, PERF_DISABLE = PERF_EVENT_IOC_DISABLE };
+
+        static void config(int e, perf_event_attr& attr) {
+            auto cache = [&](std::uint64_t id, std::uint64_t op, std::uint64_t result) {
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = id | (op << 8) | (result << 16);
+            };
+            attr.type = PERF_TYPE_HARDWARE;
+            switch (e) {
+            case Cycles: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+            case Instructions: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+            case BranchMisses: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+            case L1Misses: cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS); break;
+            default: attr.config = PERF_COUNT_HW_CACHE_MISSES; break; // LLC
+            }
+        }
+
+        void control(Control c) {
+            for (int fd : fds) if (fd >= 0) ioctl(fd, static_cast<unsigned long>(c), 0);
+        }
+
+        void collect(Sample& s) const {
+            for (int e = 0; e < EventCount; ++e) {
+                std::uint64_t v[3] = {}; // , , 
+                if (fds[e] < 0 || read(fds[e], v, sizeof v) != static_cast<ssize_t>(sizeof v) || !v[2]) continue;
+                s.have[e] = true;
+                s.values[e] = v[2] == v[1] ? v[0]
+                    : static_cast<std::uint64_t>(static_cast<double>(v[0]) * static_cast<double>(v[1]) / static_cast<double>(v[2]));
+            }
+        }
+#else
+        enum Control { PERF_RESET, PERF_ENABLE, PERF_DISABLE };
+        void control(Control) {}
+        void collect(Sample&) const {}
+#endif
+    };
+
+} // namespace Perf
@@ -0,0 +1,44 @@
+// include/pool.hpp
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <exception>
+
+namespace Pool {
+
+    // 0    
+    inline unsigned threads(unsigned requested) {
+        if (requested) return requested;
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // f(i)  i  [0, n)   ;    ,
+    //    .    .
+    template <class F>
+    void forEach(std::size_t n, unsigned threads, F&& f) {
+        if (threads <= 1 || n <= 1) {
+            for (std::size_t i = 0; i < n; ++i) f(i);
+            return;
+        }
+        std::atomic<std::size_t> next{ 0 };
+        std::exception_ptr error;
+        std::atomic<bool> failed{ false };
+        auto work = [&]() {
+            for (std::size_t i; !failed.load(std::memory_order_relaxed) && (i = next.fetch_add(1)) < n;) {
+                try { f(i); }
+                catch (...) {
+                    if (!failed.exchange(true)) error = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        auto k = static_cast<std::size_t>(threads) < n ? threads : static_cast<unsigned>(n);
+        for (unsigned t = 1; t < k; ++t) pool.emplace_back(work);
+        work();
+        for (auto& t : pool) t.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+} // namespace Pool
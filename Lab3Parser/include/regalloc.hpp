@@ -0,0 +1,135 @@
+// include/regalloc.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "tac.hpp"
+#include "cfg.hpp"
+
+namespace TAC {
+
+    struct AllocStats {
+        std::uint32_t temps = 0;    //  tN  
+        std::uint32_t maxLive = 0;  //    tN
+        std::uint32_t regs = 0;     //  
+        std::uint32_t spilled = 0;  // tN,     
+        std::uint32_t slots = 0;    //  '  
+    };
+
+    // Linear scan (Poletto/Sarkar)  tN.   t1..tK,   
+    // t(K+1)..,    TAC  .    .
+    struct TempAllocator {
+        Unit& u;
+        std::uint32_t limit;        // 0   
+        AllocStats stats;
+
+        TempAllocator(Unit& unit, std::uint32_t regs) : u(unit), limit(regs) {}
+
+        void run() {
+            if (!u.functions.empty()) return; // VM  tN      
+            auto iv = intervals();
+            if (iv.empty()) return;
+            stats.temps = static_cast<std::uint32_t>(iv.size());
+            stats.maxLive = overlap(iv);
+
+            std::vector<std::uint32_t> where(u.temps + 1, 0);
+            std::vector<Interval> spills;
+            scan(iv, limit, where, 0, &spills, stats.regs);
+            stats.spilled = static_cast<std::uint32_t>(spills.size());
+
+            //     ,   
+            auto base = limit ? limit : stats.regs;
+            std::sort(spills.begin(), spills.end(), byStart);
+            scan(spills, 0, where, base, nullptr, stats.slots);
+
+            for (auto& in : u.code) {
+                for (Operand* o : { &in.dst, &in.a, &in.b })
+                    if (o->kind == Operand::Kind::Temp) o->index = where[o->index];
+            }
+            u.temps = base + stats.slots;
+        }
+
+    private:
+        // :    i  2i,   2i+1
+        struct Interval { std::uint32_t temp; std::size_t start, end; };
+
+        static bool byStart(const Interval& a, const Interval& b) {
+            return a.start < b.start || (a.start == b.start && a.temp < b.temp);
+        }
+
+        std::vector<Interval> intervals() const {
+            constexpr std::size_t none = static_cast<std::size_t>(-1);
+            std::vector<std::size_t> lo(u.temps + 1, none), hi(u.temps + 1, 0);
+            auto touch = [&](std::uint32_t t, std::size_t p) {
+                if (lo[t] == none || p < lo[t]) lo[t] = p;
+                if (p > hi[t]) hi[t] = p;
+            };
+
+            CFG cfg(u);
+            Liveness lv(u, cfg);
+            const auto nv = static_cast<std::uint32_t>(u.vars.size());
+            for (std::size_t b = 0; b < cfg.blocks.size(); ++b) {
+                auto& bl = cfg.blocks[b];
+                if (bl.begin == bl.end) continue;
+                for (auto k : lv.in[b]) if (k >= nv) touch(k - nv, 2 * bl.begin);
+                for (auto k : lv.out[b]) if (k >= nv) touch(k - nv, 2 * (bl.end - 1) + 1);
+            }
+            for (std::size_t i = 0; i < u.code.size(); ++i) {
+                const Instr& in = u.code[i];
+                if (readsA(in.op) && in.a.kind == Operand::Kind::Temp) touch(in.a.index, 2 * i);
+                if (readsB(in.op) && in.b.kind == Operand::Kind::Temp) touch(in.b.index, 2 * i);
+                if (definesDst(in.op) && in.dst.kind == Operand::Kind::Temp) touch(in.dst.index, 2 * i + 1);
+            }
+
+            std::vector<Interval> iv;
+            for (std::uint32_t t = 1; t <= u.temps; ++t)
+                if (lo[t] != none) iv.push_back({ t, lo[t], hi[t] });
+            std::sort(iv.begin(), iv.end(), byStart);
+            return iv;
+        }
+
+        static std::uint32_t overlap(const std::vector<Interval>& iv) {
+            std::vector<std::pair<std::size_t, int>> ev;
+            ev.reserve(iv.size() * 2);
+            for (auto& i : iv) { ev.push_back({ i.start, 1 }); ev.push_back({ i.end + 1, -1 }); }
+            std::sort(ev.begin(), ev.end(), [](auto& a, auto& b) { return a.first < b.first || (a.first == b.first && a.second < b.second); });
+            int cur = 0, best = 0;
+            for (auto& e : ev) { cur += e.second; best = std::max(best, cur); }
+            return static_cast<std::uint32_t>(best);
+        }
+
+        //   r -> tN   base + r + 1
+        static void scan(const std::vector<Interval>& iv, std::uint32_t k, std::vector<std::uint32_t>& where,
+            std::uint32_t base, std::vector<Interval>* spills, std::uint32_t& used) {
+            std::vector<Interval> active; //   end
+            std::vector<std::uint32_t> reg(where.size(), 0), freeRegs;
+            std::uint32_t next = 0;
+            auto byEnd = [](const Interval& a, const Interval& b) { return a.end < b.end; };
+
+            for (auto& cur : iv) {
+                while (!active.empty() && active.front().end < cur.start) {
+                    freeRegs.push_back(reg[active.front().temp]);
+                    active.erase(active.begin());
+                }
+                std::uint32_t r;
+                if (!freeRegs.empty()) { r = freeRegs.back(); freeRegs.pop_back(); }
+                else if (k == 0 || next < k) r = next++;
+                else {
+                    //  ,   
+                    auto& last = active.back();
+                    if (last.end > cur.end) {
+                        r = reg[last.temp];
+                        spills->push_back(last);
+                        active.pop_back();
+                    }
+                    else { spills->push_back(cur); continue; }
+                }
+                reg[cur.temp] = r;
+                where[cur.temp] = base + r + 1;
+                active.insert(std::upper_bound(active.begin(), active.end(), cur, byEnd), cur);
+            }
+            used = next;
+        }
+    };
+
+} // namespace TAC
@@ -0,0 +1,264 @@
+// include/regress.hpp
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lab3.hpp"
+#include "aot.hpp"
+
+// --regress:        ,  
+//     .         lab3 ( cc  aot).
+namespace Regress {
+
+    struct Case {
+        std::string name, source;
+    };
+
+    //  :     .
+    //        ,     .
+    inline std::vector<Case> corpus() {
+        std::vector<Case> c;
+        c.push_back({ "gen-loop",
+            "int i = 0;\ndouble s = 0;\n"
+            "while (i < 200000) { s = s + i * 0.5 - i % 7; i = i + 1; }\n"
+            "print(s);\n" });
+        c.push_back({ "gen-branch",
+            "int i = 0;\nint a = 0;\nint b = 0;\n"
+            "while (i < 100000) {\n"
+            "  if (i % 3 == 0 && i % 5 != 0) { a = a + 1; }\n"
+            "  else if (i % 7 == 0 || i > 90000) { b = b + 2; }\n"
+            "  else { a = a - 1; }\n"
+            "  i = i + 1;\n"
+            "}\n"
+            "print(a);\nprint(b);\n" });
+        c.push_back({ "gen-nested",
+            "int i = 0;\ndouble t = 0;\n"
+            "while (i < 300) {\n"
+            "  int j = 0;\n"
+            "  while (j < 300) { double k = i * j; t = t + k / (j + 1); j = j + 1; }\n"
+            "  i = i + 1;\n"
+            "}\n"
+            "print(t);\n" });
+        c.push_back({ "gen-print",
+            "int i = 0;\n"
+            "while (i < 20000) { print(i / 7); i = i + 1; }\n" });
+
+        //   : , DOT  TAC    
+        std::string s;
+        s.reserve(1 << 20);
+        for (int i = 0; i < 4000; ++i) {
+            auto n = std::to_string(i);
+            s += "double v" + n + " = " + std::to_string(i % 97) + " * 1.5 + " + std::to_string(i % 13) + ";\n";
+            if (i) s += "v" + n + " = v" + n + " - v" + std::to_string(i - 1) + " / (v" + n + " + 1);\n";
+        }
+        s += "print(v3999);\n";
+        c.push_back({ "gen-straight", std::move(s) });
+        return c;
+    }
+
+    inline volatile double calibrationResult = 0.0; //     
+
+    //    : -   fmod,   Context  Binary.
+    //        ;      .
+    inline void calibration() {
+        static const std::vector<std::string> keys = [] {
+            std::vector<std::string> k;
+            for (int i = 0; i < 64; ++i) k.push_back("key" + std::to_string(i));
+            return k;
+        }();
+        std::unordered_map<std::string, double> m;
+        for (int i = 0; i < 200000; ++i) m[keys[i & 63]] += std::fmod(i, 7.0) * 0.5;
+        calibrationResult = m[keys[0]];
+    }
+
+    struct Bench {
+        std::string name; // :
+        std::function<void()> run;
+        long reps = 1;    //   
+        std::vector<double> ms{};
+    };
+
+    //  N :   ,        
+    inline double median(std::vector<double> ms) {
+        if (ms.empty()) return 0.0;
+        auto mid = ms.begin() + static_cast<std::ptrdiff_t>(ms.size() / 2);
+        std::nth_element(ms.begin(), mid, ms.end());
+        if (ms.size() % 2) return *mid;
+        return (*mid + *std::max_element(ms.begin(), mid)) / 2;
+    }
+
+    //    (     ),    :  
+    //     ,    .   
+    //  minMs  ,        .
+    inline void measure(std::vector<Bench>& benches, int samples, double minMs) {
+        using Ms = std::chrono::duration<double, std::milli>;
+        for (auto& b : benches) {
+            auto t0 = std::chrono::steady_clock::now();
+            b.run(); //   
+            double once = Ms(std::chrono::steady_clock::now() - t0).count();
+            b.reps = once >= minMs ? 1 : static_cast<long>(minMs / std::max(once, 1e-4)) + 1;
+        }
+        for (int s = 0; s < std::max(samples, 1); ++s)
+            for (auto& b : benches) {
+                auto t1 = std::chrono::steady_clock::now();
+                for (long r = 0; r < b.reps; ++r) b.run();
+                b.ms.push_back(Ms(std::chrono::steady_clock::now() - t1).count() / static_cast<double>(b.reps));
+            }
+    }
+
+    //   ,   --bench
+    struct Discard : std::streambuf {
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    struct Options {
+        int samples = 7;
+        double minMs = 10.0;
+        std::string cacheDir = ".lab3cache"; // .so  aot
+    };
+
+    //    , DOT, TAC (  ), , VM  aot.
+    // ,      (aot  cc),     skipped.
+    inline void benches(const Case& c, const Lab3::Program& program, const Options& ro,
+        std::vector<Bench>& out, std::vector<std::string>& skipped) {
+        static Discard nb;
+        static std::ostream sink(&nb);
+        auto name = [&](const char* mode) { return c.name + ":" + mode; };
+        const auto* root = &program.ast();
+
+        out.push_back({ name("parse"), [&c]() { Lab3::parse(c.source); } });
+        out.push_back({ name("dot"), [root]() { AST::writeDOT(*root, sink); } });
+        out.push_back({ name("tac"), [root]() {
+            IO::Writer w(sink);
+            TAC::Emitter em;
+            em.sink = &w;
+            em.gen(root);
+        } });
+        out.push_back({ name("tac-opt"), [root]() {
+            IO::Writer w(sink);
+            Lab3::lower(root, true).write(w);
+        } });
+        out.push_back({ name("tree"), [root]() {
+            AST::Context ctx;
+            ctx.out = &sink;
+            root->exec(ctx);
+        } });
+        if (!program.staticScopes()) {
+            skipped.push_back(name("vm") + ", " + name("aot") + ": scope errors possible (only the tree reports them)");
+            return;
+        }
+        for (bool opt : { false, true }) {
+            const auto* vm = &program.vm(opt);
+            out.push_back({ name(opt ? "vm-opt" : "vm"), [vm]() { VM::run(*vm, sink); } });
+        }
+        try {
+            AOT::Builder b{ ro.cacheDir };
+            auto mod = std::make_shared<AOT::Module>(b.build(Lab3::lower(root, true)));
+            out.push_back({ name("aot"), [mod]() { mod->run(sink); } });
+        }
+        catch (const std::exception& ex) {
+            skipped.push_back(name("aot") + ": " + ex.what());
+        }
+    }
+
+    struct Entry {
+        std::string name;
+        double ms = 0.0;
+        double tolerance = 1.5; //   /
+    };
+
+    // : ',  ms, ; '#'  
+    inline bool parseBaseline(const std::string& text, std::vector<Entry>& out, std::string& error) {
+        std::istringstream in(text);
+        std::string line;
+        for (int no = 1; std::getline(in, line); ++no) {
+            auto hash = line.find('#');
+            if (hash != std::string::npos) line.resize(hash);
+            std::istringstream ls(line);
+            Entry e;
+            if (!(ls >> e.name)) continue;
+            if (!(ls >> e.ms) || e.ms < 0) { error = "line " + std::to_string(no) + ": expected ms"; return false; }
+            if (!(ls >> e.tolerance)) e.tolerance = Entry().tolerance;
+            if (e.tolerance < 1.0) { error = "line " + std::to_string(no) + ": tolerance below 1"; return false; }
+            out.push_back(e);
+        }
+        return true;
+    }
+
+    inline void writeBaseline(std::ostream& out, const std::vector<Entry>& entries) {
+        out << "# lab3 --regress baseline: benchmark, median ms/run of N samples, tolerance (max new/base)\n"
+               "# re-record on the gate machine: lab3 --regress-record <this file> [sample.prog ...]\n";
+        char line[160];
+        for (auto& e : entries) {
+            std::snprintf(line, sizeof line, "%-28s %14.6f %6.2f\n", e.name.c_str(), e.ms, e.tolerance);
+            out << line;
+        }
+    }
+
+    //       ,   
+    constexpr double noiseMs = 0.05;
+
+    // ,   floorMs (  , aot  ), gate  :
+    //      ,  - .     
+    constexpr double floorMs = 1.0;
+
+    constexpr const char* calibrationName = "calibration";
+
+    //  ;   .    
+    //  ( calibration),  ratio   ,      .
+    inline int compare(std::ostream& out, const std::vector<Entry>& base, const std::vector<Entry>& now) {
+        auto find = [](const std::vector<Entry>& v, const std::string& name) {
+            return std::find_if(v.begin(), v.end(), [&](const Entry& e) { return e.name == name; });
+        };
+        double speed = 1.0;
+        auto bc = find(base, calibrationName), nc = find(now, calibrationName);
+        if (bc != base.end() && nc != now.end() && bc->ms > 0) speed = nc->ms / bc->ms;
+
+        char line[200];
+        std::snprintf(line, sizeof line, "machine: x%.3f of baseline speed (calibration)\n", 1.0 / speed);
+        out << line;
+        std::snprintf(line, sizeof line, "floor: %.3f ms; rows below it are marked (floor) and never fail\n", floorMs);
+        out << line;
+        std::snprintf(line, sizeof line, "%-28s %12s %12s %8s %7s  %s\n", "benchmark", "base ms", "new ms", "ratio", "limit", "status");
+        out << line;
+        int regressions = 0;
+        for (auto& n : now) {
+            if (n.name == calibrationName) continue;
+            auto b = find(base, n.name);
+            if (b == base.end()) {
+                std::snprintf(line, sizeof line, "%-28s %12s %12.4f %8s %7s  new\n", n.name.c_str(), "-", n.ms, "-", "-");
+                out << line;
+                continue;
+            }
+            double expect = b->ms * speed;
+            double ratio = expect > 0 ? n.ms / expect : 1.0;
+            const bool underFloor = n.ms < floorMs;
+            const char* status = "ok";
+            if (ratio > b->tolerance && n.ms - expect > noiseMs) {
+                if (underFloor) status = "slower";
+                else { status = "REGRESSION"; ++regressions; }
+            }
+            else if (ratio < 1.0 / b->tolerance && expect - n.ms > noiseMs) status = "faster";
+            std::snprintf(line, sizeof line, "%-28s %12.4f %12.4f %8.3f %7.2f  %s%s\n",
+                n.name.c_str(), b->ms, n.ms, ratio, b->tolerance, status, underFloor ? " (floor)" : "");
+            out << line;
+        }
+        for (auto& b : base) {
+            if (b.name != calibrationName && std::none_of(now.begin(), now.end(), [&](const Entry& e) { return e.name == b.name; })) {
+                std::snprintf(line, sizeof line, "%-28s %12.4f %12s %8s %7.2f  not run\n", b.name.c_str(), b.ms, "-", "-", b.tolerance);
+                out << line;
+            }
+        }
+        return regressions;
+    }
+
+} // namespace Regress
@@ -0,0 +1,147 @@
+// include/scopes.hpp
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "ast.hpp"
+
+namespace AST {
+
+    //      : "undefined variable", "assignment to undeclared
+    // variable", "redeclaration in the same scope". VM  aot (TAC)    
+    //   ,      . ScopeCheck  ,
+    //    :      ,   .
+    //
+    // :       (  if/while  {}),
+    //    ,        
+    //      .     ( ,  
+    // )         .
+    class ScopeCheck {
+    public:
+        bool run(const Block& root) {
+            needs.clear();
+            arrays.clear();
+            for (auto& s : root.items)
+                if (auto f = dynamic_cast<const Function*>(s.get())) body(f->body.get());
+            scopes.assign(1, Scope());
+            declared.clear();
+            ok = true;
+            for (auto& s : root.items) {
+                if (!ok) break;
+                if (!dynamic_cast<const Function*>(s.get())) stmt(s.get());
+                if (auto d = dynamic_cast<const ArrayDecl*>(s.get())) declared.insert(d);
+            }
+            return ok;
+        }
+
+    private:
+        struct Scope {
+            std::unordered_set<std::string> names;
+            bool conditional = false; //  if/while   
+        };
+
+        std::vector<Scope> scopes;
+        std::unordered_set<std::string> needs;          // ,    
+        std::unordered_set<const ArrayDecl*> arrays;    // ,    
+        std::unordered_set<const ArrayDecl*> declared;  //   ,  
+        bool ok = true;
+
+        bool visible(const std::string& name) const {
+            for (auto it = scopes.rbegin(); it != scopes.rend(); ++it)
+                if (it->names.count(name)) return true;
+            return false;
+        }
+
+        // : ,    - ,    
+        void call() {
+            for (auto& n : needs) ok = ok && scopes.front().names.count(n) != 0;
+            for (auto d : arrays) ok = ok && declared.count(d) != 0;
+        }
+
+        void expr(const Expr* e) {
+            if (auto id = dynamic_cast<const Ident*>(e)) {
+                if (id->ref == Ref::Scoped) ok = ok && visible(id->name);
+                else if (id->ref == Ref::Global) ok = ok && scopes.front().names.count(id->name) != 0;
+            }
+            else if (auto u = dynamic_cast<const Unary*>(e)) expr(u->E.get());
+            else if (auto b = dynamic_cast<const Binary*>(e)) { expr(b->L.get()); expr(b->R.get()); }
+            else if (auto c = dynamic_cast<const Call*>(e)) {
+                for (auto& a : c->args) expr(a.get());
+                call();
+            }
+            else if (auto ix = dynamic_cast<const Index*>(e)) expr(ix->index.get());
+        }
+
+        // ó if   while:        ( )
+        void branch(const Stmt* s) {
+            bool saved = scopes.back().conditional;
+            scopes.back().conditional = true;
+            stmt(s);
+            scopes.back().conditional = saved;
+        }
+
+        void stmt(const Stmt* s) {
+            if (auto b = dynamic_cast<const Block*>(s)) {
+                if (b->createScope) scopes.emplace_back();
+                for (auto& i : b->items) stmt(i.get());
+                if (b->createScope) scopes.pop_back();
+            }
+            else if (auto d = dynamic_cast<const VarDecl*>(s)) {
+                if (d->init) expr(d->init.get());
+                if (d->ref != Ref::Scoped) return;
+                ok = ok && !scopes.back().conditional && scopes.back().names.insert(d->name).second;
+            }
+            else if (auto a = dynamic_cast<const Assign*>(s)) {
+                expr(a->value.get());
+                if (a->ref == Ref::Scoped) ok = ok && visible(a->name);
+                else if (a->ref == Ref::Global) ok = ok && scopes.front().names.count(a->name) != 0;
+            }
+            else if (auto p = dynamic_cast<const Print*>(s)) expr(p->what.get());
+            else if (auto i = dynamic_cast<const If*>(s)) {
+                expr(i->cond.get());
+                branch(i->thenS.get());
+                if (i->elseS) branch(i->elseS.get());
+            }
+            else if (auto w = dynamic_cast<const While*>(s)) { expr(w->cond.get()); branch(w->body.get()); }
+            else if (auto r = dynamic_cast<const Return*>(s)) { if (r->value) expr(r->value.get()); }
+            else if (auto x = dynamic_cast<const ExprStmt*>(s)) expr(x->expr.get());
+            else if (auto ia = dynamic_cast<const IndexAssign*>(s)) { expr(ia->index.get()); expr(ia->value.get()); }
+        }
+
+        // ҳ :    ,     
+        void body(const Stmt* s) {
+            if (auto b = dynamic_cast<const Block*>(s)) { for (auto& i : b->items) body(i.get()); }
+            else if (auto d = dynamic_cast<const VarDecl*>(s)) { if (d->init) bodyExpr(d->init.get()); }
+            else if (auto a = dynamic_cast<const Assign*>(s)) {
+                bodyExpr(a->value.get());
+                if (a->ref != Ref::Local) needs.insert(a->name);
+            }
+            else if (auto p = dynamic_cast<const Print*>(s)) bodyExpr(p->what.get());
+            else if (auto i = dynamic_cast<const If*>(s)) {
+                bodyExpr(i->cond.get());
+                body(i->thenS.get());
+                if (i->elseS) body(i->elseS.get());
+            }
+            else if (auto w = dynamic_cast<const While*>(s)) { bodyExpr(w->cond.get()); body(w->body.get()); }
+            else if (auto r = dynamic_cast<const Return*>(s)) { if (r->value) bodyExpr(r->value.get()); }
+            else if (auto x = dynamic_cast<const ExprStmt*>(s)) bodyExpr(x->expr.get());
+            else if (auto ia = dynamic_cast<const IndexAssign*>(s)) {
+                arrays.insert(ia->decl);
+                bodyExpr(ia->index.get());
+                bodyExpr(ia->value.get());
+            }
+        }
+
+        void bodyExpr(const Expr* e) {
+            if (auto id = dynamic_cast<const Ident*>(e)) { if (id->ref != Ref::Local) needs.insert(id->name); }
+            else if (auto u = dynamic_cast<const Unary*>(e)) bodyExpr(u->E.get());
+            else if (auto b = dynamic_cast<const Binary*>(e)) { bodyExpr(b->L.get()); bodyExpr(b->R.get()); }
+            else if (auto c = dynamic_cast<const Call*>(e)) { for (auto& a : c->args) bodyExpr(a.get()); }
+            else if (auto ix = dynamic_cast<const Index*>(e)) {
+                arrays.insert(ix->decl);
+                bodyExpr(ix->index.get());
+            }
+        }
+    };
+
+} // namespace AST
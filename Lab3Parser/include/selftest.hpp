@@ -0,0 +1,216 @@
+// include/selftest.hpp
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <filesystem>
+#include "lab3.hpp"
+#include "aot.hpp"
+#include "server.hpp"
+
+// --self-test:     ; ,     
+//   .    (aot    cc).
+//  --serve   :  , stats, 볺,  
+//  ,  shutdown.
+namespace SelfTest {
+
+    struct Case {
+        const char* name;
+        const char* source;
+        bool lowered; //  Program::staticScopes(): VM  aot   
+    };
+
+    inline std::vector<Case> engineCases() {
+        return {
+            // ,    : VM  aot    
+            { "undefined-read", "print(y);\n", false },
+            { "undeclared-assign", "y = 3;\n", false },
+            { "scope-exit", "{ int a = 1; }\nprint(a);\n", false },
+            { "redeclaration", "int a = 1;\nint a = 2;\n", false },
+            { "output-then-error", "int x = 2;\nprint(x);\nprint(y);\n", false },
+            { "conditional-decl", "int c = 0;\nif (c) int a = 1;\nprint(c);\n", false },
+            { "loop-redeclaration", "int i = 0;\nwhile (i < 2) int k = i;\n", false },
+            { "call-before-global", "int f() { return g; }\nprint(f());\nint g = 1;\n", false },
+            //  :       
+            { "shadow", "int a = 1;\n{ int a = 2; print(a); }\nprint(a);\n", true },
+            { "loop-scope", "int i = 0;\nwhile (i < 3) { int k = i * 2; print(k); i = i + 1; }\n", true },
+            { "global-from-function", "int g = 3;\nint f(int x) { g = g + 1; return x * g; }\nprint(f(2));\nprint(g);\n", true },
+            { "recursion", "int fib(int n) { if (n < 2) { return n; } return fib(n - 1) + fib(n - 2); }\nprint(fib(10));\n", true },
+            { "arrays", "int a[4];\nint i = 0;\nwhile (i < 4) { a[i] = i * i; i = i + 1; }\nprint(a[3]);\nprint(a[4]);\n", true },
+            { "division-by-zero", "double x = 1;\nprint(x);\nprint(x / 0);\n", true },
+        };
+    }
+
+    // --steps:        ,     VM
+    inline std::vector<Case> stepCases() {
+        return {
+            { "steps-loop", "int i = 0;\nwhile (i < 10) { print(i); i = i + 1; }\n", true },
+            { "steps-nested", "int i = 0;\nwhile (i < 4) { int j = 0; while (j < i) { print(i * 10 + j); j = j + 1; } i = i + 1; }\n", true },
+            { "steps-empty-body", "int i = 0;\nwhile (i < 3) {}\nprint(i);\n", true },
+            { "steps-calls", "int f(int n) { if (n < 2) return n; return f(n - 1) + f(n - 2); }\n"
+                "int i = 0;\nwhile (i < 6) { print(f(i)); i = i + 1; }\n", true },
+            { "steps-call-args", "int g(int a, int b) { print(a); return a + b; }\nprint(g(g(1, 2), g(3, 1 / 0)));\n", true },
+        };
+    }
+
+    struct Outcome {
+        std::string out, error;
+        int status = 0;
+        bool operator==(const Outcome& o) const { return out == o.out && error == o.error && status == o.status; }
+    };
+
+    inline Outcome run(const Lab3::Program& p, Lab3::Engine engine, bool optimize, std::uint64_t maxSteps = 0) {
+        Lab3::RunOptions ro;
+        ro.engine = engine;
+        ro.optimize = optimize;
+        ro.maxSteps = maxSteps;
+        auto r = Lab3::run(p, ro);
+        return { r.out, r.error, r.status };
+    }
+
+    //  --aot  main:  ScopeCheck     ; false  aot  
+    inline bool runAot(const Lab3::Program& p, const std::string& cacheDir, Outcome& o, std::string& why) {
+        if (!p.staticScopes()) { o = run(p, Lab3::Engine::Tree, false); return true; }
+        auto unit = Lab3::lower(&p.ast(), true);
+        if (!AOT::Builder::supports(unit)) { o = run(p, Lab3::Engine::Tree, false); return true; }
+        AOT::Module mod;
+        try {
+            AOT::Builder b{ cacheDir };
+            mod = b.build(std::move(unit));
+        }
+        catch (const std::exception& ex) {
+            why = ex.what();
+            return false;
+        }
+        std::ostringstream out;
+        try { mod.run(out); }
+        catch (const std::exception& ex) { o.error = ex.what(); o.status = 4; }
+        o.out = out.str();
+        return true;
+    }
+
+    // ʳ ;      log
+    inline int engines(std::ostream& log, const std::string& cacheDir) {
+        int failed = 0;
+        auto report = [&](const std::string& what, bool ok, const std::string& note = "") {
+            log << (ok ? "ok    " : "FAIL  ") << what << note << "\n";
+            if (!ok) ++failed;
+        };
+        for (auto& c : engineCases()) {
+            std::string errors;
+            auto p = Lab3::compile(c.source, &errors);
+            if (!p) { report(std::string(c.name) + ": parse", false, " (" + errors + ")"); continue; }
+            report(std::string(c.name) + ": scope check", p.staticScopes() == c.lowered);
+            auto tree = run(p, Lab3::Engine::Tree, false);
+            report(std::string(c.name) + ": vm", run(p, Lab3::Engine::VM, false) == tree);
+            report(std::string(c.name) + ": vm-opt", run(p, Lab3::Engine::VM, true) == tree);
+            Outcome native;
+            std::string why;
+            if (runAot(p, cacheDir, native, why)) report(std::string(c.name) + ": aot", native == tree);
+            else log << "skip  " << c.name << ": aot (" << why << ")\n";
+        }
+        for (auto& c : stepCases()) {
+            std::string errors;
+            auto p = Lab3::compile(c.source, &errors);
+            if (!p) { report(std::string(c.name) + ": parse", false, " (" + errors + ")"); continue; }
+            bool vm = true, opt = true;
+            for (std::uint64_t n : { 1, 2, 3, 5, 8, 13, 100 }) {
+                auto tree = run(p, Lab3::Engine::Tree, false, n);
+                vm = vm && run(p, Lab3::Engine::VM, false, n) == tree;
+                opt = opt && run(p, Lab3::Engine::VM, true, n) == tree;
+            }
+            report(std::string(c.name) + ": vm --steps", vm);
+            report(std::string(c.name) + ": vm-opt --steps", opt);
+        }
+        // Exit   Enter,     (return,  )
+        struct Balance : Trace::Sink {
+            long enters = 0, exits = 0;
+            void event(const Trace::Event& e) override {
+                if (e.kind == Trace::Kind::Enter) ++enters;
+                if (e.kind == Trace::Kind::Exit) ++exits;
+            }
+        } balance;
+        auto traced = Lab3::compile("int f(int x) { if (x > 1) { return x * f(x - 1); } return 1; }\nprint(f(5));\nprint(1 / 0);\n");
+        Lab3::RunOptions ro;
+        ro.trace = &balance;
+        auto r = Lab3::run(traced, ro);
+        report("trace: exit on throw", r.status == 4 && balance.enters > 0 && balance.enters == balance.exits);
+        return failed;
+    }
+
+    //    handle   ; 볺    --connect
+    inline int server(std::ostream& log, std::function<Serve::Response(const Serve::Request&)> handle) {
+#ifdef _WIN32
+        (void)handle;
+        log << "skip  server (Unix sockets are not supported on this platform)\n";
+        return 0;
+#else
+        int failed = 0;
+        auto report = [&](const std::string& what, bool ok, const std::string& note = "") {
+            log << (ok ? "ok    " : "FAIL  ") << what << note << "\n";
+            if (!ok) ++failed;
+        };
+        auto path = (std::filesystem::temp_directory_path() / ("lab3-selftest." + std::to_string(::getpid()) + ".sock")).string();
+        //   :  shutdown  ,    
+        auto srv = std::make_shared<Serve::Server>();
+        srv->handle = std::move(handle);
+        auto rc = std::make_shared<std::atomic<int>>(-1);
+        std::thread t([srv, rc, path]() { *rc = srv->serveSocket(path); });
+
+        auto request = [&](const std::string& mode, const std::string& source, Serve::Response& rs, std::string& error) {
+            Serve::Request rq;
+            rq.mode = mode;
+            rq.source = source;
+            return Serve::call(path, rq, rs, error);
+        };
+        //  '  
+        auto wait = [&](std::function<bool()> done) {
+            for (int i = 0; i < 500; ++i) {
+                if (done()) return true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            return false;
+        };
+        Serve::Response rs;
+        std::string error;
+        bool up = wait([&]() { return *rc >= 0 || request("exec", "print(1 + 2);\n", rs, error); });
+        if (!up || *rc >= 0) {
+            report("server: start", false, " (" + error + ")");
+            if (*rc >= 0) t.join(); // serveSocket  
+            else { srv->stopping = true; t.detach(); }
+            return failed;
+        }
+        report("server: exec", rs.status == 0 && rs.out == "3\n");
+
+        // 볺     :       
+        int fd = Serve::connectTo(path, error);
+        if (fd >= 0) {
+            Serve::Request rq;
+            rq.mode = "exec";
+            rq.source = "int i = 0;\nwhile (i < 200000) { i = i + 1; }\nprint(i);\n";
+            Serve::SocketChannel ch(fd);
+            Serve::writeFrame(ch, Serve::encodeRequest(rq));
+        }
+        bool gone = fd >= 0 && wait([&]() {
+            return request("stats", "", rs, error) && rs.out.find("requests 2\n") != std::string::npos;
+        });
+        report("server: early disconnect", gone);
+        report("server: exec after disconnect", request("exec", "print(2 * 21);\n", rs, error) && rs.out == "42\n");
+        report("server: stats", request("stats", "", rs, error) && rs.out.find("requests 3\n") != std::string::npos);
+
+        bool down = request("shutdown", "", rs, error) && rs.status == 0;
+        down = down && wait([&]() { return *rc >= 0; });
+        report("server: shutdown", down && *rc == 0);
+        if (down) t.join();
+        else { srv->stopping = true; t.detach(); }
+        return failed;
+#endif
+    }
+
+} // namespace SelfTest
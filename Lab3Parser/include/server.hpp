@@ -0,0 +1,388 @@
+// include/server.hpp
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sstream>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace Serve {
+
+    // ----------  ----------
+    // : 4   (little-endian),    .
+    // :  " "   ,   .
+    //   mode exec|vm|tac|ast|stats|shutdown, steps N ( ), output N ()
+    // ³: "status N\nmicros T\nstdout N\nstderr M\n\n",    .
+    struct Request {
+        std::string mode = "exec";
+        std::uint64_t maxSteps = 0, maxOutput = 0; // 0   
+        std::string source;
+    };
+
+    struct Response {
+        int status = 0; //    CLI; 6   
+        std::uint64_t micros = 0;
+        std::string out, err;
+    };
+
+    constexpr std::uint32_t maxFrame = 64u << 20;
+
+    inline bool parseRequest(const std::string& frame, Request& r, std::string& error) {
+        std::size_t pos = 0;
+        for (;;) {
+            auto eol = frame.find('\n', pos);
+            if (eol == std::string::npos) { error = "missing blank line after header"; return false; }
+            std::string line = frame.substr(pos, eol - pos);
+            pos = eol + 1;
+            if (line.empty()) break;
+            auto sp = line.find(' ');
+            std::string key = line.substr(0, sp), value = sp == std::string::npos ? "" : line.substr(sp + 1);
+            if (key == "mode") r.mode = value;
+            else if (key == "steps") r.maxSteps = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "output") r.maxOutput = std::strtoull(value.c_str(), nullptr, 10);
+            else { error = "unknown header '" + key + "'"; return false; }
+        }
+        r.source = frame.substr(pos);
+        return true;
+    }
+
+    inline std::string encodeRequest(const Request& r) {
+        std::string s = "mode " + r.mode + "\n";
+        if (r.maxSteps) s += "steps " + std::to_string(r.maxSteps) + "\n";
+        if (r.maxOutput) s += "output " + std::to_string(r.maxOutput) + "\n";
+        return s + "\n" + r.source;
+    }
+
+    inline std::string encodeResponse(const Response& r) {
+        std::string s = "status " + std::to_string(r.status) + "\nmicros " + std::to_string(r.micros)
+            + "\nstdout " + std::to_string(r.out.size()) + "\nstderr " + std::to_string(r.err.size()) + "\n\n";
+        return s + r.out + r.err;
+    }
+
+    inline bool decodeResponse(const std::string& frame, Response& r) {
+        std::istringstream in(frame);
+        std::string key;
+        std::size_t nout = 0, nerr = 0;
+        if (!(in >> key >> r.status >> key >> r.micros >> key >> nout >> key >> nerr)) return false;
+        auto body = frame.find("\n\n");
+        if (body == std::string::npos || frame.size() != body + 2 + nout + nerr) return false;
+        r.out = frame.substr(body + 2, nout);
+        r.err = frame.substr(body + 2 + nout, nerr);
+        return true;
+    }
+
+    //   :   stdin/stdout
+    struct Channel {
+        virtual ~Channel() = default;
+        virtual bool read(char* p, std::size_t n) = 0;  //  n 
+        virtual bool write(const char* p, std::size_t n) = 0;
+    };
+
+    struct FileChannel : Channel {
+        FILE* in;
+        FILE* out;
+        FileChannel(FILE* i, FILE* o) : in(i), out(o) {}
+        bool read(char* p, std::size_t n) override { return std::fread(p, 1, n, in) == n; }
+        bool write(const char* p, std::size_t n) override {
+            return std::fwrite(p, 1, n, out) == n && std::fflush(out) == 0;
+        }
+    };
+
+#ifndef _WIN32
+    // 볺,    ,  EPIPE  SIGPIPE,     
+    struct SocketChannel : Channel {
+        int fd;
+        explicit SocketChannel(int f) : fd(f) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+            int on = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof on);
+#endif
+        }
+        ~SocketChannel() override { ::close(fd); }
+        bool read(char* p, std::size_t n) override {
+            while (n) {
+                auto k = ::read(fd, p, n);
+                if (k <= 0) return false;
+                p += k; n -= static_cast<std::size_t>(k);
+            }
+            return true;
+        }
+        bool write(const char* p, std::size_t n) override {
+            while (n) {
+#ifdef MSG_NOSIGNAL
+                auto k = ::send(fd, p, n, MSG_NOSIGNAL);
+#else
+                auto k = ::send(fd, p, n, 0);
+#endif
+                if (k <= 0) return false;
+                p += k; n -= static_cast<std::size_t>(k);
+            }
+            return true;
+        }
+    };
+#endif
+
+    // false      
+    inline bool readFrame(Channel& ch, std::string& frame) {
+        unsigned char len[4];
+        if (!ch.read(reinterpret_cast<char*>(len), 4)) return false;
+        std::uint32_t n = len[0] | (len[1] << 8) | (len[2] << 16) | (static_cast<std::uint32_t>(len[3]) << 24);
+        if (n > maxFrame) return false;
+        frame.resize(n);
+        return n == 0 || ch.read(&frame[0], n);
+    }
+
+    inline bool writeFrame(Channel& ch, const std::string& frame) {
+        auto n = static_cast<std::uint32_t>(frame.size());
+        std::string buf;
+        buf.reserve(4 + frame.size());
+        for (int i = 0; i < 4; ++i) buf += static_cast<char>((n >> (8 * i)) & 0xff);
+        buf += frame;
+        return ch.write(buf.data(), buf.size());
+    }
+
+    // ----------  ----------
+    // ó :  4     
+    struct Stats {
+        static constexpr int buckets = 160;
+        std::atomic<std::uint64_t> requests{ 0 }, failed{ 0 };
+        std::unordered_map<std::string, std::uint64_t> byMode; //  mutex
+        std::atomic<std::uint64_t> hist[buckets] = {};
+        std::mutex m;
+
+        static int bucketOf(std::uint64_t us) {
+            if (us == 0) return 0;
+            int b = 1 + static_cast<int>(4.0 * std::log2(static_cast<double>(us)));
+            return b < buckets ? b : buckets - 1;
+        }
+
+        void record(const std::string& mode, std::uint64_t us, bool ok) {
+            ++requests;
+            if (!ok) ++failed;
+            ++hist[bucketOf(us)];
+            std::lock_guard<std::mutex> lock(m);
+            ++byMode[mode];
+        }
+
+        //   ,    p-  
+        std::uint64_t percentile(double p) {
+            std::uint64_t total = 0, counts[buckets];
+            for (int b = 0; b < buckets; ++b) total += counts[b] = hist[b].load();
+            if (!total) return 0;
+            auto need = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(total)));
+            std::uint64_t seen = 0;
+            for (int b = 0; b < buckets; ++b) {
+                seen += counts[b];
+                if (seen >= need) return b == 0 ? 0 : static_cast<std::uint64_t>(std::ceil(std::exp2(b / 4.0)));
+            }
+            return 0;
+        }
+
+        std::string text() {
+            std::ostringstream s;
+            s << "requests " << requests.load() << "\nfailed " << failed.load() << "\n";
+            {
+                std::lock_guard<std::mutex> lock(m);
+                for (auto& kv : byMode) s << "mode " << kv.first << " " << kv.second << "\n";
+            }
+            s << "p50-us " << percentile(0.50) << "\np99-us " << percentile(0.99) << "\n";
+            return s.str();
+        }
+    };
+
+    // ----------    ----------
+    // LRU    (   ,   );
+    //      
+    template <class T>
+    struct Warm {
+        std::size_t capacity = 256;
+        std::atomic<std::uint64_t> hits{ 0 }, misses{ 0 };
+
+        // make()   ; nullptr  
+        template <class Make>
+        std::shared_ptr<const T> get(const std::string& key, Make&& make) {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                auto f = index.find(key);
+                if (f != index.end()) {
+                    lru.splice(lru.begin(), lru, f->second);
+                    ++hits;
+                    return f->second->second;
+                }
+            }
+            ++misses;
+            std::shared_ptr<const T> v = make();
+            if (!v) return v;
+            std::lock_guard<std::mutex> lock(m);
+            auto f = index.find(key);
+            if (f != index.end()) return f->second->second; //    
+            lru.emplace_front(key, v);
+            index.emplace(lru.front().first, lru.begin());
+            if (lru.size() > capacity) {
+                index.erase(lru.back().first);
+                lru.pop_back();
+            }
+            return v;
+        }
+
+    private:
+        std::mutex m;
+        std::list<std::pair<std::string, std::shared_ptr<const T>>> lru;
+        std::unordered_map<std::string_view, typename decltype(lru)::iterator> index; //      lru
+    };
+
+    // ----------  ----------
+    struct Server {
+        std::function<Response(const Request&)> handle;
+        std::function<std::string()> extraStats; // .   
+        Stats stats;
+        std::atomic<bool> stopping{ false };
+
+        //   '   ; false  ' 
+        bool session(Channel& ch) {
+            std::string frame;
+            while (!stopping && readFrame(ch, frame)) {
+                Request rq;
+                Response rs;
+                std::string error;
+                auto t0 = std::chrono::steady_clock::now();
+                if (!parseRequest(frame, rq, error)) { rs.status = 6; rs.err = "Bad request: " + error + "\n"; }
+                else if (rq.mode == "stats") rs.out = stats.text() + (extraStats ? extraStats() : "");
+                else if (rq.mode == "shutdown") stopping = true;
+                else rs = handle(rq);
+                rs.micros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t0).count());
+                if (rs.status != 6 && rq.mode != "stats" && rq.mode != "shutdown") stats.record(rq.mode, rs.micros, rs.status == 0);
+                if (!writeFrame(ch, encodeResponse(rs))) return false;
+                if (rq.mode == "shutdown") wake(); //   
+            }
+            return true;
+        }
+
+        //   stdin/stdout,   
+        int serveStdio() {
+            FileChannel ch(stdin, stdout);
+            session(ch);
+            return 0;
+        }
+
+        // Unix-:  '    
+        int serveSocket(const std::string& path) {
+#ifdef _WIN32
+            (void)path;
+            std::fprintf(stderr, "Unix sockets are not supported on this platform; use --serve -\n");
+            return 1;
+#else
+            sockaddr_un addr{};
+            if (path.size() >= sizeof addr.sun_path) { std::fprintf(stderr, "Socket path too long\n"); return 1; }
+            addr.sun_family = AF_UNIX;
+            std::snprintf(addr.sun_path, sizeof addr.sun_path, "%s", path.c_str());
+            listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            ::unlink(path.c_str());
+            if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0
+                || ::listen(listenFd, 64) != 0) {
+                std::perror("serve");
+                return 1;
+            }
+            while (!stopping) {
+                int fd = ::accept(listenFd, nullptr, nullptr);
+                if (fd < 0) break;
+                {
+                    std::lock_guard<std::mutex> lock(cm);
+                    clients.insert(fd);
+                    ++active;
+                }
+                std::thread([this, fd]() {
+                    {
+                        SocketChannel ch(fd);
+                        session(ch);
+                        std::lock_guard<std::mutex> lock(cm);
+                        clients.erase(fd); //  close,  wake    fd
+                    }
+                    std::lock_guard<std::mutex> lock(cm);
+                    if (--active == 0) idle.notify_all();
+                }).detach();
+            }
+            {
+                std::unique_lock<std::mutex> lock(cm);
+                idle.wait(lock, [this]() { return active == 0; });
+            }
+            ::close(listenFd);
+            ::unlink(path.c_str());
+            return 0;
+#endif
+        }
+
+    private:
+        int listenFd = -1;
+        std::mutex cm;
+        std::condition_variable idle;
+        std::unordered_set<int> clients; //  '
+        std::size_t active = 0;
+
+        //  accept  read   '
+        void wake() {
+#ifndef _WIN32
+            if (listenFd >= 0) ::shutdown(listenFd, SHUT_RDWR);
+            std::lock_guard<std::mutex> lock(cm);
+            for (int fd : clients) ::shutdown(fd, SHUT_RDWR);
+#endif
+        }
+    };
+
+#ifndef _WIN32
+    //  '    -1 (error )
+    inline int connectTo(const std::string& path, std::string& error) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof addr.sun_path) { error = "socket path too long"; return -1; }
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof addr.sun_path, "%s", path.c_str());
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            if (fd >= 0) ::close(fd);
+            error = "cannot connect to " + path;
+            return -1;
+        }
+        return fd;
+    }
+#endif
+
+    // 볺  --connect:  ,  
+    inline bool call(const std::string& path, const Request& rq, Response& rs, std::string& error) {
+#ifdef _WIN32
+        (void)path; (void)rq; (void)rs;
+        error = "Unix sockets are not supported on this platform";
+        return false;
+#else
+        int fd = connectTo(path, error);
+        if (fd < 0) return false;
+        SocketChannel ch(fd);
+        std::string frame;
+        if (!writeFrame(ch, encodeRequest(rq)) || !readFrame(ch, frame) || !decodeResponse(frame, rs)) {
+            error = "bad response from " + path;
+            return false;
+        }
+        return true;
+#endif
+    }
+
+} // namespace Serve
@@ -0,0 +1,375 @@
+// include/ssa.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "tac.hpp"
+#include "cfg.hpp"
+
+namespace TAC {
+
+    // SSA    (tN   ).    
+    // Cooper/Harvey/Kennedy, phi     (semi-pruned:  ,
+    //    ),      .
+    struct SSA {
+        struct Name { std::uint32_t var, version; };
+        struct Phi {
+            std::uint32_t var = 0, dst = 0;      // dst  SSA-'
+            std::vector<std::uint32_t> args;     //   cfg.blocks[b].pred
+        };
+
+        Unit& u;
+        CFG cfg;
+        std::vector<std::size_t> idom;           // npos    
+        std::vector<std::vector<std::size_t>> kids, frontier;
+        std::vector<Name> names;                 // SSA-' -> (, )
+        std::vector<std::vector<Phi>> phis;      //  
+        std::vector<Instr> code;                 // Var-    names
+
+        // ϳ      ,   
+        //     '. ,   ,   .
+        bool conventional = true;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        explicit SSA(Unit& unit) : u(unit) {}
+
+        void build() {
+            if (!u.functions.empty()) throw std::runtime_error("SSA: functions are not supported");
+            cfg.build(u);
+            code = u.code;
+            dominators();
+            placePhis();
+            rename();
+        }
+
+        // ---------- dump ----------
+        void nameText(std::string& s, std::uint32_t n) const {
+            s += u.vars[names[n].var];
+            s += '.';
+            s += std::to_string(names[n].version);
+        }
+
+        void write(IO::Writer& out) const {
+            std::string line;
+            auto operand = [this](std::string& s, const Operand& o) {
+                if (o.kind == Operand::Kind::Var) nameText(s, o.index);
+                else u.operand(s, o);
+            };
+            for (std::size_t b = 0; b < cfg.blocks.size(); ++b) {
+                auto& bl = cfg.blocks[b];
+                std::size_t i = bl.begin;
+                for (; i < bl.end && code[i].op == Op::Label; ++i) {
+                    line.clear(); u.render(line, code[i]); line += '\n';
+                    out.write(line.data(), line.size());
+                }
+                for (auto& p : phis[b]) {
+                    line.clear();
+                    nameText(line, p.dst);
+                    line += " = phi(";
+                    for (std::size_t k = 0; k < p.args.size(); ++k) {
+                        if (k) line += ", ";
+                        nameText(line, p.args[k]);
+                    }
+                    line += ")\n";
+                    out.write(line.data(), line.size());
+                }
+                for (; i < bl.end; ++i) {
+                    line.clear(); u.render(line, code[i], operand); line += '\n';
+                    out.write(line.data(), line.size());
+                }
+            }
+        }
+
+        // ---------- out of SSA ----------
+        //     Unit::code
+        void destroy() {
+            if (conventional) {
+                for (auto& in : code) {
+                    if (in.dst.kind == Operand::Kind::Var) in.dst.index = names[in.dst.index].var;
+                    if (in.a.kind == Operand::Kind::Var) in.a.index = names[in.a.index].var;
+                    if (in.b.kind == Operand::Kind::Var) in.b.index = names[in.b.index].var;
+                }
+                u.code.swap(code);
+                return;
+            }
+
+            //     ', phi ->  ﳿ  
+            std::vector<Operand> real(names.size());
+            for (std::size_t n = 0; n < names.size(); ++n) {
+                if (names[n].version == 0) { real[n] = Operand::var(names[n].var); continue; }
+                std::string s = u.vars[names[n].var] + "_" + std::to_string(names[n].version);
+                while (u.hasVar(s)) s += '_';
+                real[n] = u.var(s);
+            }
+            auto map = [&](Operand& o) { if (o.kind == Operand::Kind::Var) o = real[o.index]; };
+            for (auto& in : code) { map(in.dst); map(in.a); map(in.b); }
+
+            const std::size_t nb = cfg.blocks.size();
+            std::vector<std::vector<Instr>> tail(nb), fallSplit(nb);
+            std::vector<Instr> far; //    -
+            std::vector<std::uint32_t> retarget(nb, 0);
+
+            auto labelOf = [&](std::size_t b) -> std::uint32_t {
+                auto& bl = cfg.blocks[b];
+                if (bl.begin < bl.end && code[bl.begin].op == Op::Label) return code[bl.begin].label;
+                return 0;
+            };
+
+            for (std::size_t b = 0; b < nb; ++b) {
+                if (phis[b].empty()) continue;
+                auto& preds = cfg.blocks[b].pred;
+                for (std::size_t k = 0; k < preds.size(); ++k) {
+                    auto p = preds[k];
+                    std::vector<std::pair<Operand, Operand>> moves;
+                    for (auto& ph : phis[b]) moves.push_back({ real[ph.dst], real[ph.args[k]] });
+                    auto copies = sequence(moves);
+
+                    auto& pb = cfg.blocks[p];
+                    const Instr* last = pb.end > pb.begin ? &code[pb.end - 1] : nullptr;
+                    bool cond = last && isJump(last->op) && last->op != Op::Goto;
+                    if (!cond) { tail[p].insert(tail[p].end(), copies.begin(), copies.end()); continue; }
+
+                    //  : ﳿ   
+                    bool viaJump = cfg.blockOf.count(last->label) && cfg.blockOf.at(last->label) == b;
+                    bool viaFall = p + 1 == b;
+                    auto Lsplit = ++u.labels;
+                    if (viaFall) {
+                        Instr l; l.op = Op::Label; l.label = Lsplit;
+                        fallSplit[p].push_back(l);
+                        fallSplit[p].insert(fallSplit[p].end(), copies.begin(), copies.end());
+                        if (viaJump) retarget[p] = Lsplit;
+                    }
+                    else if (viaJump) {
+                        Instr l; l.op = Op::Label; l.label = Lsplit;
+                        far.push_back(l);
+                        far.insert(far.end(), copies.begin(), copies.end());
+                        Instr g; g.op = Op::Goto; g.label = labelOf(b);
+                        far.push_back(g);
+                        retarget[p] = Lsplit;
+                    }
+                }
+            }
+
+            std::vector<Instr> out;
+            out.reserve(code.size() + far.size());
+            for (std::size_t b = 0; b < nb; ++b) {
+                auto& bl = cfg.blocks[b];
+                const Instr* last = bl.end > bl.begin ? &code[bl.end - 1] : nullptr;
+                bool jump = last && isJump(last->op);
+                std::size_t body = jump ? bl.end - 1 : bl.end;
+                out.insert(out.end(), code.begin() + bl.begin, code.begin() + body);
+                out.insert(out.end(), tail[b].begin(), tail[b].end());
+                if (jump) {
+                    Instr j = *last;
+                    if (retarget[b]) j.label = retarget[b];
+                    out.push_back(j);
+                }
+                out.insert(out.end(), fallSplit[b].begin(), fallSplit[b].end());
+            }
+            if (!far.empty()) {
+                auto Lend = ++u.labels;
+                if (out.empty() || out.back().op != Op::Goto) { Instr g; g.op = Op::Goto; g.label = Lend; out.push_back(g); }
+                out.insert(out.end(), far.begin(), far.end());
+                Instr l; l.op = Op::Label; l.label = Lend; out.push_back(l);
+            }
+            u.code.swap(out);
+        }
+
+    private:
+        //  ﳿ -> ;     tN
+        std::vector<Instr> sequence(std::vector<std::pair<Operand, Operand>> moves) {
+            std::vector<Instr> out;
+            auto copy = [&](Operand d, Operand s) { Instr c; c.op = Op::Copy; c.dst = d; c.a = s; out.push_back(c); };
+            moves.erase(std::remove_if(moves.begin(), moves.end(),
+                [](const std::pair<Operand, Operand>& m) { return m.first == m.second; }), moves.end());
+            while (!moves.empty()) {
+                bool progress = false;
+                for (std::size_t i = 0; i < moves.size(); ++i) {
+                    bool read = false;
+                    for (auto& m : moves) if (m.second == moves[i].first) { read = true; break; }
+                    if (read) continue;
+                    copy(moves[i].first, moves[i].second);
+                    moves.erase(moves.begin() + static_cast<std::ptrdiff_t>(i));
+                    progress = true;
+                    break;
+                }
+                if (progress) continue;
+                auto t = Operand::temp(++u.temps);
+                copy(t, moves[0].second);
+                for (auto& m : moves) if (m.second == moves[0].second) m.second = t;
+            }
+            return out;
+        }
+
+        // ---------- dominators ----------
+        void dominators() {
+            const std::size_t n = cfg.blocks.size();
+            std::vector<std::size_t> rpo, order(n, npos);
+            {
+                std::vector<char> seen(n, 0);
+                std::vector<std::pair<std::size_t, std::size_t>> st{ { 0, 0 } };
+                seen[0] = 1;
+                std::vector<std::size_t> post;
+                while (!st.empty()) {
+                    auto& [b, k] = st.back();
+                    if (k < cfg.blocks[b].succ.size()) {
+                        auto s = cfg.blocks[b].succ[k++];
+                        if (!seen[s]) { seen[s] = 1; st.push_back({ s, 0 }); }
+                    }
+                    else { post.push_back(b); st.pop_back(); }
+                }
+                rpo.assign(post.rbegin(), post.rend());
+                for (std::size_t i = 0; i < rpo.size(); ++i) order[rpo[i]] = i;
+            }
+
+            idom.assign(n, npos);
+            idom[0] = 0;
+            auto intersect = [&](std::size_t a, std::size_t b) {
+                while (a != b) {
+                    while (order[a] > order[b]) a = idom[a];
+                    while (order[b] > order[a]) b = idom[b];
+                }
+                return a;
+            };
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (std::size_t i = 1; i < rpo.size(); ++i) {
+                    auto b = rpo[i];
+                    std::size_t nd = npos;
+                    for (auto p : cfg.blocks[b].pred) {
+                        if (idom[p] == npos) continue;
+                        nd = nd == npos ? p : intersect(p, nd);
+                    }
+                    if (nd != idom[b]) { idom[b] = nd; changed = true; }
+                }
+            }
+
+            kids.assign(n, {});
+            frontier.assign(n, {});
+            for (std::size_t b = 1; b < n; ++b)
+                if (idom[b] != npos) kids[idom[b]].push_back(b);
+            for (std::size_t b = 0; b < n; ++b) {
+                if (idom[b] == npos || cfg.blocks[b].pred.size() < 2) continue;
+                for (auto p : cfg.blocks[b].pred) {
+                    if (idom[p] == npos) continue;
+                    for (auto r = p; r != idom[b]; r = idom[r]) {
+                        auto& f = frontier[r];
+                        if (f.empty() || f.back() != b) f.push_back(b);
+                        if (r == 0) break;
+                    }
+                }
+            }
+            idom[0] = npos;
+        }
+
+        // ---------- phi ----------
+        void placePhis() {
+            const std::size_t n = cfg.blocks.size();
+            const std::size_t nv = u.vars.size();
+            std::vector<char> global(nv, 0);
+            std::vector<std::vector<std::size_t>> defsites(nv);
+            std::vector<char> killed(nv, 0);
+            std::vector<std::uint32_t> touched;
+
+            for (std::size_t b = 0; b < n; ++b) {
+                if (!reachable(b)) continue;
+                for (auto i = cfg.blocks[b].begin; i < cfg.blocks[b].end; ++i) {
+                    const Instr& in = code[i];
+                    auto use = [&](const Operand& o) {
+                        if (o.kind == Operand::Kind::Var && !killed[o.index]) global[o.index] = 1;
+                    };
+                    if (readsA(in.op)) use(in.a);
+                    if (readsB(in.op)) use(in.b);
+                    if (definesDst(in.op) && in.dst.kind == Operand::Kind::Var) {
+                        auto v = in.dst.index;
+                        if (!killed[v]) { killed[v] = 1; touched.push_back(v); }
+                        if (defsites[v].empty() || defsites[v].back() != b) defsites[v].push_back(b);
+                    }
+                }
+                for (auto v : touched) killed[v] = 0;
+                touched.clear();
+            }
+
+            phis.assign(n, {});
+            std::vector<std::size_t> has(n, npos), queued(n, npos);
+            for (std::uint32_t v = 0; v < nv; ++v) {
+                if (!global[v]) continue;
+                std::vector<std::size_t> work = defsites[v];
+                for (auto b : work) queued[b] = v;
+                while (!work.empty()) {
+                    auto b = work.back(); work.pop_back();
+                    for (auto d : frontier[b]) {
+                        if (has[d] == v) continue;
+                        has[d] = v;
+                        Phi p; p.var = v;
+                        p.args.assign(cfg.blocks[d].pred.size(), v); //  :  0
+                        phis[d].push_back(std::move(p));
+                        if (queued[d] != v) { queued[d] = v; work.push_back(d); }
+                    }
+                }
+            }
+        }
+
+        bool reachable(std::size_t b) const { return b == 0 || idom[b] != npos; }
+
+        // ---------- renaming ----------
+        void rename() {
+            const std::size_t nv = u.vars.size();
+            std::vector<std::uint32_t> counter(nv, 0);
+            std::vector<std::vector<std::uint32_t>> stack(nv);
+            names.clear();
+            for (std::uint32_t v = 0; v < nv; ++v) { //  0    
+                names.push_back({ v, 0 });
+                stack[v].push_back(v);
+            }
+            auto fresh = [&](std::uint32_t v) {
+                auto id = static_cast<std::uint32_t>(names.size());
+                names.push_back({ v, ++counter[v] });
+                stack[v].push_back(id);
+                return id;
+            };
+
+            //      0
+            struct Frame { std::size_t b, kid; std::vector<std::uint32_t> pushed; };
+            std::vector<Frame> st;
+            st.push_back({ 0, 0, {} });
+            bool enter = true;
+            while (!st.empty()) {
+                auto& f = st.back();
+                if (enter) {
+                    auto b = f.b;
+                    for (auto& p : phis[b]) { p.dst = fresh(p.var); f.pushed.push_back(p.var); }
+                    for (auto i = cfg.blocks[b].begin; i < cfg.blocks[b].end; ++i) {
+                        Instr& in = code[i];
+                        if (readsA(in.op) && in.a.kind == Operand::Kind::Var) in.a.index = stack[in.a.index].back();
+                        if (readsB(in.op) && in.b.kind == Operand::Kind::Var) in.b.index = stack[in.b.index].back();
+                        if (definesDst(in.op) && in.dst.kind == Operand::Kind::Var) {
+                            auto v = in.dst.index;
+                            in.dst.index = fresh(v);
+                            f.pushed.push_back(v);
+                        }
+                    }
+                    for (auto s : cfg.blocks[b].succ) {
+                        auto& preds = cfg.blocks[s].pred;
+                        auto k = static_cast<std::size_t>(std::find(preds.begin(), preds.end(), b) - preds.begin());
+                        for (auto& p : phis[s]) p.args[k] = stack[p.var].back();
+                    }
+                }
+                if (f.kid < kids[f.b].size()) {
+                    auto c = kids[f.b][f.kid++];
+                    st.push_back({ c, 0, {} });
+                    enter = true;
+                    continue;
+                }
+                for (auto v : f.pushed) stack[v].pop_back();
+                st.pop_back();
+                enter = false;
+            }
+        }
+    };
+
+} // namespace TAC
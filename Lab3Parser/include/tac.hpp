@@ -1,24 +1,400 @@
 // include/tac.hpp
 #pragma once
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 #include "ast.hpp"
+#include "dag.hpp"
+#include "writer.hpp"
 
 namespace TAC {
 
+    // ---------- IR ----------
+    //       (, )   tN
+    struct Operand {
+        enum class Kind : std::uint8_t { None, Var, Temp, Const };
+        Kind kind = Kind::None;
+        std::uint32_t index = 0;
+
+        static Operand var(std::uint32_t i) { return { Kind::Var, i }; }
+        static Operand temp(std::uint32_t i) { return { Kind::Temp, i }; }
+        static Operand constant(std::uint32_t i) { return { Kind::Const, i }; }
+
+        bool operator==(const Operand& o) const { return kind == o.kind && index == o.index; }
+        bool operator!=(const Operand& o) const { return !(*this == o); }
+    };
+
+    enum class Op : std::uint8_t {
+        Copy,                       // dst = a
+        Neg,                        // dst = - a
+        Add, Sub, Mul, Div, Mod,    // dst = a op b
+        IfRel,                      // if a rel b goto label
+        IfFalseRel,                 // ifFalse a rel b goto label
+        If,                         // if a goto label
+        IfFalse,                    // ifFalse a goto label
+        Goto,                       // goto label
+        Label,                      // label:
+        Print,                      // print a
+        Param,                      // param a
+        Call,                       // dst = call f, n   (label   )
+        Return,                     // return a
+        Func,                       // func f(p1, p2):   (label   )
+        Load,                       // dst = arr[a]      (label   )
+        Store,                      // arr[a] = b
+        Array,                      // array arr[n]: 
+        Step                        // step:      --steps (Emitter::steps)
+    };
+
+    enum class Rel : std::uint8_t { LT, LE, GT, GE, EQ, NE };
+
+    struct Instr {
+        Op op = Op::Copy;
+        Rel rel = Rel::LT;
+        bool unchecked = false;  // Load/Store:     (arrays.hpp)
+        Operand dst, a, b;
+        std::uint32_t label = 0; // Ln
+    };
+
+    inline bool definesDst(Op op) {
+        switch (op) {
+        case Op::Copy: case Op::Neg:
+        case Op::Add: case Op::Sub: case Op::Mul: case Op::Div: case Op::Mod:
+        case Op::Call: case Op::Load:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline bool isJump(Op op) {
+        return op == Op::IfRel || op == Op::IfFalseRel || op == Op::If || op == Op::IfFalse || op == Op::Goto;
+    }
+
+    inline bool readsA(Op op) {
+        return op != Op::Goto && op != Op::Label && op != Op::Call && op != Op::Func && op != Op::Array && op != Op::Step;
+    }
+    inline bool readsB(Op op) {
+        return op == Op::Add || op == Op::Sub || op == Op::Mul || op == Op::Div || op == Op::Mod
+            || op == Op::IfRel || op == Op::IfFalseRel || op == Op::Store;
+    }
+
+    inline const char* opText(Op op) {
+        switch (op) {
+        case Op::Add: return "+"; case Op::Sub: return "-";
+        case Op::Mul: return "*"; case Op::Div: return "/";
+        case Op::Mod: return "%";
+        default: return "?";
+        }
+    }
+
+    inline const char* relText(Rel r) {
+        switch (r) {
+        case Rel::LT: return "<";  case Rel::LE: return "<=";
+        case Rel::GT: return ">";  case Rel::GE: return ">=";
+        case Rel::EQ: return "=="; case Rel::NE: return "!=";
+        }
+        return "?";
+    }
+
+    // :    Func   Func ( ),   
+    struct Function {
+        std::string name;
+        std::vector<Operand> params; // -
+    };
+
+    // :    (a[...]),   a_N
+    struct Array {
+        std::string name;
+        std::uint32_t size = 0;
+    };
+
+    //    ;  '   write
+    struct Unit {
+        std::vector<Instr> code;
+        std::vector<Function> functions;
+        std::vector<Array> arrays;
+        std::vector<double> consts;
+        std::vector<std::string> constText; //   
+        std::vector<std::string> vars;
+        std::uint32_t temps = 0, labels = 0;
+        IO::Digits digits = IO::Digits::Twelve; //   
+
+        Operand var(const std::string& name) {
+            auto f = varIds.find(name);
+            if (f != varIds.end()) return Operand::var(f->second);
+            auto i = static_cast<std::uint32_t>(vars.size());
+            vars.push_back(name);
+            varIds.emplace(name, i);
+            return Operand::var(i);
+        }
+
+        bool hasVar(const std::string& name) const { return varIds.count(name) != 0; }
+
+        std::uint32_t function(const std::string& name) {
+            auto f = funcIds.find(name);
+            if (f != funcIds.end()) return f->second;
+            auto i = static_cast<std::uint32_t>(functions.size());
+            functions.push_back({ name, {} });
+            funcIds.emplace(name, i);
+            return i;
+        }
+
+        //  ;  '  name_N
+        std::uint32_t array(const std::string& name, std::uint32_t size) {
+            std::string real = name;
+            for (std::uint32_t k = 1; arrayIds.count(real); ++k) real = name + "_" + std::to_string(k);
+            auto i = static_cast<std::uint32_t>(arrays.size());
+            arrays.push_back({ real, size });
+            arrayIds.emplace(std::move(real), i);
+            return i;
+        }
+
+        //    arrays.size(),   
+        std::uint32_t arrayId(const std::string& name) const {
+            auto f = arrayIds.find(name);
+            return f != arrayIds.end() ? f->second : static_cast<std::uint32_t>(arrays.size());
+        }
+
+        Operand constant(double v) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &v, sizeof v);
+            auto f = constIds.find(bits);
+            if (f != constIds.end()) return Operand::constant(f->second);
+            auto i = static_cast<std::uint32_t>(consts.size());
+            consts.push_back(v);
+            constText.push_back(IO::numberText(v, digits));
+            constIds.emplace(bits, i);
+            return Operand::constant(i);
+        }
+
+        void operand(std::string& s, const Operand& o) const {
+            switch (o.kind) {
+            case Operand::Kind::Var: s += vars[o.index]; break;
+            case Operand::Kind::Temp: s += 't'; s += std::to_string(o.index); break;
+            case Operand::Kind::Const: s += constText[o.index]; break;
+            default: break;
+            }
+        }
+
+        void render(std::string& s, const Instr& in) const {
+            render(s, in, [this](std::string& t, const Operand& o) { operand(t, o); });
+        }
+
+        //   ,      (. SSA-)
+        template <class OperandText>
+        void render(std::string& s, const Instr& in, OperandText&& operand) const {
+            auto lbl = [&](std::uint32_t l) { s += 'L'; s += std::to_string(l); };
+            switch (in.op) {
+            case Op::Copy: operand(s, in.dst); s += " = "; operand(s, in.a); break;
+            case Op::Neg: operand(s, in.dst); s += " = - "; operand(s, in.a); break;
+            case Op::Add: case Op::Sub: case Op::Mul: case Op::Div: case Op::Mod:
+                operand(s, in.dst); s += " = "; operand(s, in.a);
+                s += ' '; s += opText(in.op); s += ' '; operand(s, in.b);
+                break;
+            case Op::IfRel:
+                s += "if "; operand(s, in.a); s += ' '; s += relText(in.rel); s += ' ';
+                operand(s, in.b); s += " goto "; lbl(in.label);
+                break;
+            case Op::IfFalseRel:
+                s += "ifFalse "; operand(s, in.a); s += ' '; s += relText(in.rel); s += ' ';
+                operand(s, in.b); s += " goto "; lbl(in.label);
+                break;
+            case Op::If: s += "if "; operand(s, in.a); s += " goto "; lbl(in.label); break;
+            case Op::IfFalse: s += "ifFalse "; operand(s, in.a); s += " goto "; lbl(in.label); break;
+            case Op::Goto: s += "goto "; lbl(in.label); break;
+            case Op::Label: lbl(in.label); s += ':'; break;
+            case Op::Print: s += "print "; operand(s, in.a); break;
+            case Op::Step: s += "step"; break;
+            case Op::Param: s += "param "; operand(s, in.a); break;
+            case Op::Call:
+                operand(s, in.dst); s += " = call "; s += functions[in.label].name;
+                s += ", "; s += std::to_string(functions[in.label].params.size());
+                break;
+            case Op::Return: s += "return "; operand(s, in.a); break;
+            case Op::Func: {
+                auto& f = functions[in.label];
+                s += "func "; s += f.name; s += '(';
+                for (std::size_t i = 0; i < f.params.size(); ++i) {
+                    if (i) s += ", ";
+                    operand(s, f.params[i]);
+                }
+                s += "):";
+                break;
+            }
+            case Op::Load:
+                operand(s, in.dst); s += " = "; s += arrays[in.label].name;
+                s += '['; operand(s, in.a); s += ']';
+                if (in.unchecked) s += " unchecked";
+                break;
+            case Op::Store:
+                s += arrays[in.label].name; s += '['; operand(s, in.a); s += "] = "; operand(s, in.b);
+                if (in.unchecked) s += " unchecked";
+                break;
+            case Op::Array:
+                s += "array "; s += arrays[in.label].name;
+                s += '['; s += std::to_string(arrays[in.label].size); s += ']';
+                break;
+            }
+        }
+
+        void write(IO::Writer& out) const {
+            std::string line;
+            for (auto& in : code) {
+                line.clear();
+                render(line, in);
+                line += '\n';
+                out.write(line.data(), line.size());
+            }
+        }
+
+        void write(std::ostream& os) const {
+            IO::Writer out(os);
+            write(out);
+        }
+
+    private:
+        std::unordered_map<std::string, std::uint32_t> varIds;
+        std::unordered_map<std::uint64_t, std::uint32_t> constIds;
+        std::unordered_map<std::string, std::uint32_t> funcIds;
+        std::unordered_map<std::string, std::uint32_t> arrayIds;
+    };
+
+    // TAC ,  ,   ,   ' x_N.
+    //      ,  .
+    struct Renames {
+        std::unordered_map<const AST::VarDecl*, std::string> names;
+
+        void plan(const AST::Block* root) {
+            names.clear();
+            std::unordered_set<std::string> taken; //    VarDecl 
+            collect(root, taken);
+            std::unordered_map<std::string, std::uint32_t> shadows;
+            std::vector<std::unordered_set<std::string>> scopes(1);
+            walk(root, scopes, taken, shadows);
+        }
+
+        const std::string& of(const AST::VarDecl* vd) const {
+            auto f = names.find(vd);
+            return f != names.end() ? f->second : vd->name;
+        }
+
+    private:
+        static void collect(const AST::Stmt* s, std::unordered_set<std::string>& taken) {
+            using namespace AST;
+            if (auto vd = dynamic_cast<const VarDecl*>(s)) taken.insert(vd->name);
+            else if (auto iff = dynamic_cast<const AST::If*>(s)) {
+                collect(iff->thenS.get(), taken);
+                if (iff->elseS) collect(iff->elseS.get(), taken);
+            }
+            else if (auto wh = dynamic_cast<const AST::While*>(s)) collect(wh->body.get(), taken);
+            else if (auto bl = dynamic_cast<const Block*>(s)) for (auto& it : bl->items) collect(it.get(), taken);
+        }
+
+        void walk(const AST::Stmt* s, std::vector<std::unordered_set<std::string>>& scopes,
+            std::unordered_set<std::string>& taken, std::unordered_map<std::string, std::uint32_t>& shadows) {
+            using namespace AST;
+            if (auto vd = dynamic_cast<const VarDecl*>(s)) {
+                if (!scopes.back().insert(vd->name).second) return; //  
+                bool outer = false;
+                for (std::size_t i = 0; i + 1 < scopes.size(); ++i) outer = outer || scopes[i].count(vd->name) != 0;
+                if (!outer) return;
+                std::string real;
+                do real = vd->name + "_" + std::to_string(++shadows[vd->name]);
+                while (taken.count(real));
+                taken.insert(real);
+                names.emplace(vd, std::move(real));
+            }
+            else if (auto iff = dynamic_cast<const AST::If*>(s)) {
+                walk(iff->thenS.get(), scopes, taken, shadows);
+                if (iff->elseS) walk(iff->elseS.get(), scopes, taken, shadows);
+            }
+            else if (auto wh = dynamic_cast<const AST::While*>(s)) walk(wh->body.get(), scopes, taken, shadows);
+            else if (auto bl = dynamic_cast<const Block*>(s)) {
+                if (bl->createScope) scopes.emplace_back();
+                for (auto& it : bl->items) walk(it.get(), scopes, taken, shadows);
+                if (bl->createScope) scopes.pop_back();
+            }
+        }
+    };
+
     struct Emitter {
-        int tmp = 0, lbl = 0;
-        std::vector<std::string> out;
+        Unit unit;
+
+        // ' DAG:        
+        const DAG::Graph* dag = nullptr;
+        std::unordered_map<int, Operand> cse; //  DAG -> tN
 
-        std::string newT() { std::ostringstream s; s << "t" << (++tmp); return s.str(); }
-        std::string newL() { std::ostringstream s; s << "L" << (++lbl); return s.str(); }
-        void emit(const std::string& s) { out.push_back(s); }
+        //  :     sink   
+        IO::Writer* sink = nullptr;
+        std::string line;
+        std::size_t emitted = 0;
+
+        // '   -> '  TAC   
+        using Scope = std::unordered_map<std::string, std::string>;
+        std::vector<Scope> scopes = std::vector<Scope>(1);
+        Renames ownRenames;
+        const Renames* renames = &ownRenames;
+
+        // :    ,  ,  
+        std::vector<const AST::Function*> pending;
+        std::unordered_map<const AST::Function*, std::uint32_t> funcIds;
+        std::vector<Operand> slots; //   ->   
+        bool calls = false;         //    : -  
+        bool steps = false;         // step ,  Context::step:         
+        std::size_t callsEmitted = 0;
+        std::unordered_map<const AST::ArrayDecl*, std::uint32_t> arrayIds;
+
+        const std::string& nameOf(const std::string& name) const {
+            for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+                auto f = it->find(name);
+                if (f != it->end()) return f->second;
+            }
+            return name;
+        }
+
+        Operand declare(const AST::VarDecl* vd) {
+            auto& top = scopes.back();
+            auto f = top.find(vd->name);
+            if (f != top.end()) return unit.var(f->second);
+            return unit.var(top.emplace(vd->name, renames->of(vd)).first->second);
+        }
+
+        Operand newT() { return Operand::temp(++unit.temps); }
+        std::uint32_t newL() { return ++unit.labels; }
+        void emit(const Instr& in) {
+            ++emitted;
+            if (!sink) { unit.code.push_back(in); return; }
+            line.clear();
+            unit.render(line, in);
+            line += '\n';
+            sink->write(line.data(), line.size());
+        }
+
+        void emitCopy(Operand d, Operand a) { Instr in; in.op = Op::Copy; in.dst = d; in.a = a; emit(in); }
+        void emitOp(Op op, Operand d, Operand a, Operand b = {}) { Instr in; in.op = op; in.dst = d; in.a = a; in.b = b; emit(in); }
+        void emitJump(Op op, Operand a, std::uint32_t l) { Instr in; in.op = op; in.a = a; in.label = l; emit(in); }
+        void emitIfRel(Rel r, Operand a, Operand b, std::uint32_t l) { Instr in; in.op = Op::IfRel; in.rel = r; in.a = a; in.b = b; in.label = l; emit(in); }
+        void emitGoto(std::uint32_t l) { Instr in; in.op = Op::Goto; in.label = l; emit(in); }
+        void emitLabel(std::uint32_t l) { Instr in; in.op = Op::Label; in.label = l; emit(in); }
+
+        static bool relOf(AST::BinOp op, Rel& r) {
+            using AST::BinOp;
+            switch (op) {
+            case BinOp::LT: r = Rel::LT; return true; case BinOp::LE: r = Rel::LE; return true;
+            case BinOp::GT: r = Rel::GT; return true; case BinOp::GE: r = Rel::GE; return true;
+            case BinOp::EQ: r = Rel::EQ; return true; case BinOp::NE: r = Rel::NE; return true;
+            default: return false;
+            }
+        }
 
         //   :  e  -> Ltrue,  -> Lfalse
-        void genCond(const AST::Expr* e, const std::string& Ltrue, const std::string& Lfalse) {
+        void genCond(const AST::Expr* e, std::uint32_t Ltrue, std::uint32_t Lfalse) {
             using namespace AST;
 
             // NOT:  
@@ -31,150 +407,233 @@ namespace TAC {
                 if (b->op == BinOp::And) {
                     auto Lmid = newL();
                     genCond(b->L.get(), Lmid, Lfalse);
-                    emit(Lmid + ":");
-                    genCond(b->R.get(), Ltrue, Lfalse);
+                    emitLabel(Lmid);
+                    genCondScoped(b->R.get(), Ltrue, Lfalse);
                     return;
                 }
                 //   ( )
                 if (b->op == BinOp::Or) {
                     auto Lmid = newL();
                     genCond(b->L.get(), Ltrue, Lmid);
-                    emit(Lmid + ":");
-                    genCond(b->R.get(), Ltrue, Lfalse);
+                    emitLabel(Lmid);
+                    genCondScoped(b->R.get(), Ltrue, Lfalse);
                     return;
                 }
                 // :    ,  tN
-                auto rel = [&](BinOp op)->const char* {
-                    switch (op) {
-                    case BinOp::LT: return "<";  case BinOp::LE: return "<=";
-                    case BinOp::GT: return ">";  case BinOp::GE: return ">=";
-                    case BinOp::EQ: return "=="; case BinOp::NE: return "!=";
-                    default: return nullptr;
-                    }
-                    };
-                if (auto op = rel(b->op)) {
-                    auto a = genExpr(b->L.get());
+                Rel r;
+                if (relOf(b->op, r)) {
+                    auto a = pin(genExpr(b->L.get()), b->R.get());
                     auto c = genExpr(b->R.get());
-                    emit(std::string("if ") + a + " " + op + " " + c + " goto " + Ltrue);
-                    emit("goto " + Lfalse);
+                    emitIfRel(r, a, c, Ltrue);
+                    emitGoto(Lfalse);
                     return;
                 }
             }
 
             //  :      
             auto v = genExpr(e);
-            emit("if " + v + " goto " + Ltrue);
-            emit("goto " + Lfalse);
+            emitJump(Op::If, v, Ltrue);
+            emitGoto(Lfalse);
+        }
+
+        //   && / ||   :  tN     
+        void genCondScoped(const AST::Expr* e, std::uint32_t Ltrue, std::uint32_t Lfalse) {
+            if (!dag) { genCond(e, Ltrue, Lfalse); return; }
+            auto saved = cse;
+            auto before = callsEmitted;
+            genCond(e, Ltrue, Lfalse);
+            cse = std::move(saved);
+            if (callsEmitted != before) cse.clear(); //    
+        }
+
+        static bool hasCall(const AST::Expr* e) {
+            using namespace AST;
+            if (dynamic_cast<const Call*>(e)) return true;
+            if (auto u = dynamic_cast<const Unary*>(e)) return hasCall(u->E.get());
+            if (auto b = dynamic_cast<const Binary*>(e)) return hasCall(b->L.get()) || hasCall(b->R.get());
+            if (auto ix = dynamic_cast<const Index*>(e)) return hasCall(ix->index.get());
+            return false;
+        }
+
+        //    ;       (later), 
+        //    tN     
+        Operand pin(Operand v, const AST::Expr* later) {
+            if (!calls || v.kind != Operand::Kind::Var || !hasCall(later)) return v;
+            auto t = newT();
+            emitCopy(t, v);
+            return t;
+        }
+
+        Operand varOf(const AST::Ident* id) {
+            if (id->ref == AST::Ref::Local) return slots[id->slot];
+            return unit.var(id->ref == AST::Ref::Global ? id->name : nameOf(id->name));
+        }
+
+        std::uint32_t arrayOf(const AST::ArrayDecl* d) {
+            auto it = arrayIds.find(d);
+            if (it != arrayIds.end()) return it->second;
+            return arrayIds.emplace(d, unit.array(d->name, d->size)).first->second;
+        }
+
+        std::uint32_t functionId(const AST::Function* f) {
+            auto it = funcIds.find(f);
+            if (it != funcIds.end()) return it->second;
+            auto id = unit.function(f->name);
+            funcIds.emplace(f, id);
+            pending.push_back(f);
+            //     planSlots,      (call   )
+            for (auto& p : f->params) unit.functions[id].params.push_back(unit.var(f->name + "." + p.second));
+            return id;
         }
 
         // ---------- expressions ----------
-        std::string genExpr(const AST::Expr* e) {
+        Operand genExpr(const AST::Expr* e) {
+            int key = dag ? dag->idOf(e) : -1;
+            if (key < 0) return genNode(e);
+            auto f = cse.find(key);
+            if (f != cse.end()) return f->second;
+            auto v = genNode(e);
+            if (dag->nodes[key].kind == DAG::Kind::Unary || dag->nodes[key].kind == DAG::Kind::Binary) cse.emplace(key, v);
+            return v;
+        }
+
+        Operand genNode(const AST::Expr* e) {
             using namespace AST;
 
             if (auto n = dynamic_cast<const Number*>(e)) {
-                std::ostringstream s; s << std::setprecision(12) << n->value; return s.str();
+                return unit.constant(n->value);
             }
             if (auto id = dynamic_cast<const Ident*>(e)) {
-                return id->name;
+                return varOf(id);
             }
             if (auto u = dynamic_cast<const Unary*>(e)) {
                 auto v = genExpr(u->E.get());
                 auto t = newT();
                 if (u->op == UnOp::Neg) {
-                    emit(t + " = - " + v);
+                    emitOp(Op::Neg, t, v);
                 }
                 else { // Not
                     auto ltrue = newL(), lend = newL();
-                    emit("if " + v + " goto " + ltrue);
-                    emit(t + " = 1");
-                    emit("goto " + lend);
-                    emit(ltrue + ":");
-                    emit(t + " = 0");
-                    emit(lend + ":");
+                    emitJump(Op::If, v, ltrue);
+                    emitCopy(t, unit.constant(1));
+                    emitGoto(lend);
+                    emitLabel(ltrue);
+                    emitCopy(t, unit.constant(0));
+                    emitLabel(lend);
                 }
                 return t;
             }
             if (auto b = dynamic_cast<const Binary*>(e)) {
-                auto a = genExpr(b->L.get());
+                // &&  ||  :     ,   Binary::eval
+                if (b->op == BinOp::And || b->op == BinOp::Or) {
+                    auto ltrue = newL(), lfalse = newL(), lend = newL();
+                    genCond(e, ltrue, lfalse);
+                    auto t = newT();
+                    emitLabel(ltrue);
+                    emitCopy(t, unit.constant(1));
+                    emitGoto(lend);
+                    emitLabel(lfalse);
+                    emitCopy(t, unit.constant(0));
+                    emitLabel(lend);
+                    return t;
+                }
+
+                auto a = pin(genExpr(b->L.get()), b->R.get());
                 auto c = genExpr(b->R.get());
                 auto t = newT();
 
+                Rel r;
                 switch (b->op) {
-                case BinOp::Add: emit(t + " = " + a + " + " + c); break;
-                case BinOp::Sub: emit(t + " = " + a + " - " + c); break;
-                case BinOp::Mul: emit(t + " = " + a + " * " + c); break;
-                case BinOp::Div: emit(t + " = " + a + " / " + c); break;
-                case BinOp::Mod: emit(t + " = " + a + " % " + c); break;
+                case BinOp::Add: emitOp(Op::Add, t, a, c); break;
+                case BinOp::Sub: emitOp(Op::Sub, t, a, c); break;
+                case BinOp::Mul: emitOp(Op::Mul, t, a, c); break;
+                case BinOp::Div: emitOp(Op::Div, t, a, c); break;
+                case BinOp::Mod: emitOp(Op::Mod, t, a, c); break;
 
                 case BinOp::LT: case BinOp::LE: case BinOp::GT:
                 case BinOp::GE: case BinOp::EQ: case BinOp::NE: {
                     auto ltrue = newL(), lend = newL();
-                    std::string op = (b->op == BinOp::LT ? "<" : b->op == BinOp::LE ? "<=" :
-                        b->op == BinOp::GT ? ">" : b->op == BinOp::GE ? ">=" :
-                        b->op == BinOp::EQ ? "==" : "!=");
-                    emit("if " + a + " " + op + " " + c + " goto " + ltrue);
-                    emit(t + " = 0");
-                    emit("goto " + lend);
-                    emit(ltrue + ":");
-                    emit(t + " = 1");
-                    emit(lend + ":");
+                    relOf(b->op, r);
+                    emitIfRel(r, a, c, ltrue);
+                    emitCopy(t, unit.constant(0));
+                    emitGoto(lend);
+                    emitLabel(ltrue);
+                    emitCopy(t, unit.constant(1));
+                    emitLabel(lend);
                     break;
                 }
 
-                case BinOp::And: {
-                    auto lfalse = newL(), lend = newL();
-                    emit("ifFalse " + a + " goto " + lfalse);
-                    emit("ifFalse " + c + " goto " + lfalse);
-                    emit(t + " = 1");
-                    emit("goto " + lend);
-                    emit(lfalse + ":");
-                    emit(t + " = 0");
-                    emit(lend + ":");
-                    break;
-                }
-
-                case BinOp::Or: {
-                    auto ltrue = newL(), lend = newL();
-                    emit("if " + a + " goto " + ltrue);
-                    emit("if " + c + " goto " + ltrue);
-                    emit(t + " = 0");
-                    emit("goto " + lend);
-                    emit(ltrue + ":");
-                    emit(t + " = 1");
-                    emit(lend + ":");
-                    break;
+                default: break;
                 }
+                return t;
+            }
+            if (auto c = dynamic_cast<const Call*>(e)) {
+                //   ,  param   call
+                if (steps) { Instr st; st.op = Op::Step; emit(st); }
+                std::vector<Operand> vals;
+                vals.reserve(c->args.size());
+                for (std::size_t i = 0; i < c->args.size(); ++i) {
+                    auto v = genExpr(c->args[i].get());
+                    if (calls && v.kind == Operand::Kind::Var)
+                        for (std::size_t k = i + 1; k < c->args.size(); ++k)
+                            if (hasCall(c->args[k].get())) { v = pin(v, c->args[k].get()); break; }
+                    vals.push_back(v);
                 }
+                for (auto& v : vals) emitJump(Op::Param, v, 0);
+                auto t = newT();
+                Instr in; in.op = Op::Call; in.dst = t; in.label = functionId(c->fn);
+                emit(in);
+                ++callsEmitted;
+                cse.clear();
+                return t;
+            }
+            if (auto ix = dynamic_cast<const Index*>(e)) {
+                auto i = genExpr(ix->index.get());
+                auto t = newT();
+                Instr in; in.op = Op::Load; in.dst = t; in.a = i; in.label = arrayOf(ix->decl); in.unchecked = !ix->checked;
+                emit(in);
                 return t;
             }
 
-            return "/*unsupported-expr*/";
+            throw std::runtime_error("TAC: unsupported expression");
         }
 
         // ---------- statements ----------
         void genStmt(const AST::Stmt* s) {
             using namespace AST;
 
+            cse.clear();
+
             if (auto vd = dynamic_cast<const VarDecl*>(s)) {
-                if (vd->init) {
-                    auto v = genExpr(vd->init.get());
-                    emit(vd->name + " = " + v);
-                }
-                else {
-                    emit(vd->name + " = 0");
-                }
+                auto v = vd->init ? genExpr(vd->init.get()) : unit.constant(0);
+                emitCopy(vd->ref == Ref::Local ? slots[vd->slot] : declare(vd), v);
                 return;
             }
 
             if (auto as = dynamic_cast<const Assign*>(s)) {
                 auto v = genExpr(as->value.get());
-                emit(as->name + " = " + v);
+                if (as->ref == Ref::Local) emitCopy(slots[as->slot], v);
+                else emitCopy(unit.var(as->ref == Ref::Global ? as->name : nameOf(as->name)), v);
+                return;
+            }
+
+            if (auto ia = dynamic_cast<const IndexAssign*>(s)) {
+                auto i = pin(genExpr(ia->index.get()), ia->value.get());
+                auto v = genExpr(ia->value.get());
+                Instr in; in.op = Op::Store; in.a = i; in.b = v; in.label = arrayOf(ia->decl); in.unchecked = !ia->checked;
+                emit(in);
+                return;
+            }
+
+            if (auto ad = dynamic_cast<const ArrayDecl*>(s)) {
+                Instr in; in.op = Op::Array; in.label = arrayOf(ad);
+                emit(in);
                 return;
             }
 
             if (auto pr = dynamic_cast<const Print*>(s)) {
                 auto v = genExpr(pr->what.get());
-                emit("print " + v);
+                emitJump(Op::Print, v, 0);
                 return;
             }
 
@@ -184,43 +643,109 @@ namespace TAC {
                     // if (cond) then;
                     auto Lend = newL();
                     genCond(iff->cond.get(), Lthen, Lend);
-                    emit(Lthen + ":");
+                    emitLabel(Lthen);
                     genStmt(iff->thenS.get());
-                    emit(Lend + ":");
+                    emitLabel(Lend);
                 }
                 else {
                     // if (cond) then; else else;
                     auto Lelse = newL(), Lend = newL();
                     genCond(iff->cond.get(), Lthen, Lelse);
-                    emit(Lthen + ":");
+                    emitLabel(Lthen);
                     genStmt(iff->thenS.get());
-                    emit("goto " + Lend);
-                    emit(Lelse + ":");
+                    emitGoto(Lend);
+                    emitLabel(Lelse);
                     genStmt(iff->elseS.get());
-                    emit(Lend + ":");
+                    emitLabel(Lend);
                 }
                 return;
             }
 
             if (auto wh = dynamic_cast<const AST::While*>(s)) {
                 auto Lbegin = newL(), Lbody = newL(), Lend = newL();
-                emit(Lbegin + ":");
+                emitLabel(Lbegin);
                 genCond(wh->cond.get(), Lbody, Lend);
-                emit(Lbody + ":");
+                emitLabel(Lbody);
+                if (steps) { Instr st; st.op = Op::Step; emit(st); }
                 genStmt(wh->body.get());
-                emit("goto " + Lbegin);
-                emit(Lend + ":");
+                emitGoto(Lbegin);
+                emitLabel(Lend);
                 return;
             }
 
             if (auto bl = dynamic_cast<const Block*>(s)) {
+                if (bl->createScope) scopes.emplace_back();
                 for (auto& it : bl->items) genStmt(it.get());
+                if (bl->createScope) scopes.pop_back();
                 return;
             }
+
+            if (auto rt = dynamic_cast<const AST::Return*>(s)) {
+                auto v = rt->value ? genExpr(rt->value.get()) : unit.constant(0);
+                emitJump(Op::Return, v, 0);
+                return;
+            }
+
+            if (auto es = dynamic_cast<const ExprStmt*>(s)) {
+                genExpr(es->expr.get());
+                return;
+            }
+            // Function  ,   
+        }
+
+        //   f: f.x;       f.x_N
+        void planSlots(const AST::Function* f) {
+            slots.assign(f->slots, Operand());
+            std::unordered_set<std::string> taken;
+            auto name = [&](const std::string& n) {
+                std::string real = f->name + "." + n;
+                for (std::uint32_t k = 1; !taken.insert(real).second; ++k) real = f->name + "." + n + "_" + std::to_string(k);
+                return unit.var(real);
+            };
+            for (std::size_t i = 0; i < f->params.size(); ++i) slots[i] = name(f->params[i].second);
+            declared(f->body.get(), name);
         }
 
-        void gen(const AST::Block* root) { genStmt(root); }
-        void write(std::ostream& os) const { for (auto& l : out) os << l << "\n"; }
+        template<class Name>
+        void declared(const AST::Stmt* s, Name& name) {
+            using namespace AST;
+            if (auto vd = dynamic_cast<const VarDecl*>(s)) slots[vd->slot] = name(vd->name);
+            else if (auto iff = dynamic_cast<const AST::If*>(s)) {
+                declared(iff->thenS.get(), name);
+                if (iff->elseS) declared(iff->elseS.get(), name);
+            }
+            else if (auto wh = dynamic_cast<const AST::While*>(s)) declared(wh->body.get(), name);
+            else if (auto bl = dynamic_cast<const Block*>(s)) for (auto& it : bl->items) declared(it.get(), name);
+        }
+
+        void genFunction(const AST::Function* f) {
+            auto id = funcIds.at(f);
+            planSlots(f);
+            Instr in; in.op = Op::Func; in.label = id;
+            emit(in);
+            genStmt(f->body.get());
+            emitJump(Op::Return, unit.constant(0), 0);
+        }
+
+        void gen(const AST::Block* root) {
+            ownRenames.plan(root);
+            renames = &ownRenames;
+            scopes.assign(1, {});
+            calls = false;
+            for (auto& it : root->items) calls = calls || dynamic_cast<const AST::Function*>(it.get());
+            genStmt(root);
+            //       pending
+            for (std::size_t i = 0; i < pending.size(); ++i) genFunction(pending[i]);
+        }
+
+        //  root->items[begin, end)   ;     
+        void genItems(const AST::Block* root, std::size_t begin, std::size_t end, const Renames& plan) {
+            renames = &plan;
+            scopes.assign(1, {});
+            for (std::size_t i = begin; i < end; ++i) genStmt(root->items[i].get());
+        }
+        void write(std::ostream& os) const { unit.write(os); }
+        void write(IO::Writer& out) const { unit.write(out); }
     };
 
 } // namespace TAC
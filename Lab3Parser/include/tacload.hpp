@@ -0,0 +1,248 @@
+// include/tacload.hpp
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <string_view>
+#include "tac.hpp"
+
+namespace TAC {
+
+    //   Unit::write:  tac.txt    Unit.  tN 
+    // ,   ,   .
+    struct Loader {
+        Unit unit;
+
+        void load(const char* text, std::size_t size) {
+            const char* p = text;
+            const char* end = text + size;
+            while (p < end) {
+                const char* eol = p;
+                while (eol < end && *eol != '\n') ++eol;
+                ++line;
+                parseLine(p, eol);
+                p = eol + 1;
+            }
+            for (std::uint32_t l = 1; l < defined.size(); ++l)
+                if (used[l] && !defined[l]) fail("undefined label L" + std::to_string(l));
+            for (auto& c : calls) {
+                line = c.line;
+                auto& f = unit.functions[c.fn];
+                if (!funcDefined[c.fn]) fail("undefined function " + f.name);
+                if (f.params.size() != c.args) fail(f.name + " takes " + std::to_string(f.params.size()) + " params");
+            }
+        }
+
+    private:
+        std::size_t line = 0;
+        std::vector<char> defined, used; //   
+        std::vector<char> funcDefined;   //   
+        struct CallSite { std::size_t line; std::uint32_t fn; std::size_t args; };
+        std::vector<CallSite> calls;     //    
+        std::vector<std::string_view> tok;
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::runtime_error("TAC line " + std::to_string(line) + ": " + what);
+        }
+
+        void parseLine(const char* p, const char* end) {
+            const char* p0 = p;
+            tok.clear();
+            while (p < end) {
+                while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+                const char* b = p;
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\r') ++p;
+                if (p > b) tok.emplace_back(b, static_cast<std::size_t>(p - b));
+            }
+            if (tok.empty()) return;
+
+            Instr in;
+            const auto n = tok.size();
+            if (n == 1 && tok[0].size() > 1 && tok[0].back() == ':') {
+                in.op = Op::Label;
+                in.label = label(tok[0].substr(0, tok[0].size() - 1), true);
+            }
+            else if (n == 1 && tok[0] == "step") in.op = Op::Step;
+            else if (n == 2 && tok[0] == "goto") {
+                in.op = Op::Goto;
+                in.label = label(tok[1], false);
+            }
+            else if (n == 2 && tok[0] == "print") {
+                in.op = Op::Print;
+                in.a = operand(tok[1]);
+            }
+            else if (n == 2 && tok[0] == "param") {
+                in.op = Op::Param;
+                in.a = operand(tok[1]);
+            }
+            else if (n == 2 && tok[0] == "return") {
+                in.op = Op::Return;
+                in.a = operand(tok[1]);
+            }
+            else if (tok[0] == "func") in = func(p0, end);
+            else if (n == 2 && tok[0] == "array") {
+                auto open = tok[1].find('[');
+                if (open == 0 || open == std::string_view::npos || tok[1].back() != ']') fail("expected 'array a[n]'");
+                std::string name(tok[1].substr(0, open));
+                auto size = tok[1].substr(open + 1, tok[1].size() - open - 2);
+                if (!digits(size)) fail("bad array size '" + std::string(size) + "'");
+                auto len = std::strtoul(std::string(size).c_str(), nullptr, 10);
+                if (len == 0 || len > AST::maxArray) fail("bad array size '" + std::string(size) + "'");
+                if (unit.arrayId(name) != unit.arrays.size()) fail("array " + name + " declared twice");
+                in.op = Op::Array;
+                in.label = unit.array(name, static_cast<std::uint32_t>(len));
+            }
+            // "unchecked"  :     AST,     
+            else if ((n == 3 || (n == 4 && tok[3] == "unchecked")) && tok[1] == "=" && tok[2].find('[') != std::string_view::npos) {
+                in.op = Op::Load;
+                in.dst = operand(tok[0]);
+                if (in.dst.kind == Operand::Kind::Const) fail("assignment to a constant");
+                in.label = element(tok[2], in.a);
+            }
+            else if ((n == 3 || (n == 4 && tok[3] == "unchecked")) && tok[1] == "=" && tok[0].find('[') != std::string_view::npos) {
+                in.op = Op::Store;
+                in.label = element(tok[0], in.a);
+                in.b = operand(tok[2]);
+            }
+            else if (n == 5 && tok[1] == "=" && tok[2] == "call") {
+                in.op = Op::Call;
+                in.dst = operand(tok[0]);
+                if (in.dst.kind == Operand::Kind::Const) fail("assignment to a constant");
+                if (tok[3].size() < 2 || tok[3].back() != ',') fail("expected 'call f, n'");
+                in.label = function(tok[3].substr(0, tok[3].size() - 1));
+                if (!digits(tok[4])) fail("bad param count '" + std::string(tok[4]) + "'");
+                calls.push_back({ line, in.label, std::strtoul(std::string(tok[4]).c_str(), nullptr, 10) });
+            }
+            else if ((tok[0] == "if" || tok[0] == "ifFalse") && (n == 4 || n == 6) && tok[n - 2] == "goto") {
+                bool neg = tok[0] == "ifFalse";
+                in.a = operand(tok[1]);
+                if (n == 6) {
+                    in.op = neg ? Op::IfFalseRel : Op::IfRel;
+                    in.rel = rel(tok[2]);
+                    in.b = operand(tok[3]);
+                }
+                else in.op = neg ? Op::IfFalse : Op::If;
+                in.label = label(tok[n - 1], false);
+            }
+            else if ((n == 3 || n == 4 || n == 5) && tok[1] == "=") {
+                in.dst = operand(tok[0]);
+                if (in.dst.kind == Operand::Kind::Const) fail("assignment to a constant");
+                if (n == 3) { in.op = Op::Copy; in.a = operand(tok[2]); }
+                else if (n == 4) {
+                    if (tok[2] != "-") fail("expected unary '-'");
+                    in.op = Op::Neg;
+                    in.a = operand(tok[3]);
+                }
+                else {
+                    in.op = arith(tok[3]);
+                    in.a = operand(tok[2]);
+                    in.b = operand(tok[4]);
+                }
+            }
+            else fail("unrecognised instruction");
+            unit.code.push_back(in);
+        }
+
+        static bool digits(std::string_view s) {
+            if (s.empty()) return false;
+            for (char c : s) if (c < '0' || c > '9') return false;
+            return true;
+        }
+
+        Operand operand(std::string_view s) {
+            char c = s[0];
+            bool num = (c >= '0' && c <= '9') || c == '.' || ((c == '-' || c == '+') && s.size() > 1);
+            if (num) {
+                std::string t(s);
+                char* e = nullptr;
+                double v = std::strtod(t.c_str(), &e);
+                if (e != t.c_str() + t.size()) fail("bad number '" + t + "'");
+                return unit.constant(v);
+            }
+            if (s.size() > 1 && c == 't' && digits(s.substr(1))) {
+                auto i = static_cast<std::uint32_t>(std::strtoul(std::string(s.substr(1)).c_str(), nullptr, 10));
+                if (i == 0) fail("bad temporary 't0'");
+                if (i > unit.temps) unit.temps = i;
+                return Operand::temp(i);
+            }
+            return unit.var(std::string(s));
+        }
+
+        // a[i]   ,   index
+        std::uint32_t element(std::string_view s, Operand& index) {
+            auto open = s.find('[');
+            if (open == 0 || s.back() != ']' || open + 2 >= s.size()) fail("bad element '" + std::string(s) + "'");
+            std::string name(s.substr(0, open));
+            auto id = unit.arrayId(name);
+            if (id == unit.arrays.size()) fail("undefined array " + name);
+            index = operand(s.substr(open + 1, s.size() - open - 2));
+            return id;
+        }
+
+        std::uint32_t function(std::string_view s) {
+            auto f = unit.function(std::string(s));
+            if (f >= funcDefined.size()) funcDefined.resize(f + 1, 0);
+            return f;
+        }
+
+        // func f(a, b):     ,  
+        Instr func(const char* p, const char* end) {
+            std::string_view s(p, static_cast<std::size_t>(end - p));
+            auto open = s.find('('), close = s.rfind("):");
+            if (open == std::string_view::npos || close == std::string_view::npos || close < open) fail("expected 'func f(params):'");
+            auto trim = [](std::string_view v) {
+                while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+                while (!v.empty() && (v.back() == ' ' || v.back() == '\t' || v.back() == '\r')) v.remove_suffix(1);
+                return v;
+            };
+            auto name = trim(s.substr(s.find("func") + 4, open - s.find("func") - 4));
+            if (name.empty() || !trim(s.substr(close + 2)).empty()) fail("expected 'func f(params):'");
+            Instr in;
+            in.op = Op::Func;
+            in.label = function(name);
+            if (funcDefined[in.label]) fail("function " + std::string(name) + " defined twice");
+            funcDefined[in.label] = 1;
+            auto& params = unit.functions[in.label].params;
+            auto list = trim(s.substr(open + 1, close - open - 1));
+            while (!list.empty()) {
+                auto comma = list.find(',');
+                auto one = trim(list.substr(0, comma));
+                auto o = one.empty() ? Operand() : operand(one);
+                if (o.kind != Operand::Kind::Var) fail("bad parameter '" + std::string(one) + "'");
+                params.push_back(o);
+                if (comma == std::string_view::npos) break;
+                list = list.substr(comma + 1);
+                if (trim(list).empty()) fail("bad parameter list");
+            }
+            return in;
+        }
+
+        std::uint32_t label(std::string_view s, bool define) {
+            if (s.size() < 2 || s[0] != 'L' || !digits(s.substr(1))) fail("bad label '" + std::string(s) + "'");
+            auto l = static_cast<std::uint32_t>(std::strtoul(std::string(s.substr(1)).c_str(), nullptr, 10));
+            if (l >= defined.size()) { defined.resize(l + 1, 0); used.resize(l + 1, 0); }
+            if (define) {
+                if (defined[l]) fail("label " + std::string(s) + " defined twice");
+                defined[l] = 1;
+            }
+            else used[l] = 1;
+            if (l > unit.labels) unit.labels = l;
+            return l;
+        }
+
+        Rel rel(std::string_view s) const {
+            for (Rel r : { Rel::LT, Rel::LE, Rel::GT, Rel::GE, Rel::EQ, Rel::NE })
+                if (s == relText(r)) return r;
+            fail("bad relation '" + std::string(s) + "'");
+        }
+
+        Op arith(std::string_view s) const {
+            for (Op op : { Op::Add, Op::Sub, Op::Mul, Op::Div, Op::Mod })
+                if (s == opText(op)) return op;
+            fail("bad operator '" + std::string(s) + "'");
+        }
+    };
+
+} // namespace TAC
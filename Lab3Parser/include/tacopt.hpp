@@ -0,0 +1,456 @@
+// include/tacopt.hpp
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "tac.hpp"
+#include "cfg.hpp"
+
+namespace TAC {
+
+    struct OptStats {
+        std::size_t before = 0, after = 0;
+        std::size_t folded = 0;     //    
+        std::size_t propagated = 0; //  /
+        std::size_t coalesced = 0;  //  "x = tN"
+        std::size_t dead = 0;       //  
+        std::size_t threaded = 0;   //   goto 
+        std::size_t inverted = 0;   // "if c goto L1; goto L2; L1:" -> "ifFalse c goto L2"
+        std::size_t labels = 0;     //  
+        std::size_t jumps = 0;      //    
+        std::size_t unreachable = 0;
+        std::size_t reordered = 0;  //     
+    };
+
+    // ҳ  ,    Binary::eval
+    inline double foldRel(Rel r, double a, double b) {
+        switch (r) {
+        case Rel::LT: return a < b; case Rel::LE: return a <= b;
+        case Rel::GT: return a > b; case Rel::GE: return a >= b;
+        case Rel::EQ: return a == b; case Rel::NE: return a != b;
+        }
+        return 0.0;
+    }
+
+    //      tac.txt (12  ), 
+    //  TAC   ,  AST;    
+    inline bool exactText(double v, IO::Digits digits = IO::Digits::Twelve) {
+        if (!std::isfinite(v)) return false;
+        if (digits == IO::Digits::Shortest) return true;
+        char tmp[IO::numberChars + 1];
+        tmp[IO::formatNumber(tmp, v, digits)] = '\0';
+        return std::strtod(tmp, nullptr) == v;
+    }
+
+    // /       ,
+    //  "tN = ...; x = tN"      
+    struct Optimizer {
+        Unit& u;
+        OptStats stats;
+
+        explicit Optimizer(Unit& unit) : u(unit) {}
+
+        //    - :     
+        void run() {
+            stats.before = u.code.size();
+            stats.after = stats.before;
+            if (!u.functions.empty()) return;
+            bool changed = true;
+            while (changed) {
+                changed = propagate();
+                changed = coalesce() || changed;
+                changed = eliminate() || changed;
+                changed = cleanFlow() || changed;
+            }
+            if (reorder()) cleanFlow();
+            stats.after = u.code.size();
+        }
+
+    private:
+        std::uint32_t keys() const { return Liveness::keys(u); }
+        std::uint32_t key(const Operand& o) const { return Liveness::key(u, o); }
+        static bool isName(const Operand& o) { return Liveness::isName(o); }
+        double cval(const Operand& o) const { return u.consts[o.index]; }
+        static bool isConst(const Operand& o) { return o.kind == Operand::Kind::Const; }
+
+        // ĳ  -         
+        //      
+        bool mayTrap(const Instr& in) const {
+            if (in.op == Op::Load) return !in.unchecked;
+            return in.op == Op::Div && !(isConst(in.b) && cval(in.b) != 0.0);
+        }
+
+        void compact(std::vector<char>& drop) {
+            std::size_t w = 0;
+            for (std::size_t i = 0; i < u.code.size(); ++i)
+                if (!drop[i]) u.code[w++] = u.code[i];
+            u.code.resize(w);
+        }
+
+        bool propagate() {
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            std::unordered_map<std::uint32_t, Operand> known;                 // ' -> 
+            std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> users; //  -> ﳿ
+
+            auto kill = [&](const Operand& d) {
+                auto k = key(d);
+                known.erase(k);
+                auto f = users.find(k);
+                if (f == users.end()) return;
+                for (auto c : f->second) {
+                    auto g = known.find(c);
+                    if (g != known.end() && g->second == d) known.erase(g);
+                }
+                users.erase(f);
+            };
+            auto subst = [&](Operand& o) {
+                if (!isName(o)) return;
+                auto f = known.find(key(o));
+                if (f == known.end()) return;
+                o = f->second;
+                ++stats.propagated;
+                changed = true;
+            };
+
+            for (std::size_t i = 0; i < u.code.size(); ++i) {
+                Instr& in = u.code[i];
+                if (in.op == Op::Label) { known.clear(); users.clear(); continue; }
+
+                if (readsA(in.op)) subst(in.a);
+                if (readsB(in.op)) subst(in.b);
+
+                // ---------- folding ----------
+                if (in.op == Op::Neg && isConst(in.a)) {
+                    in.a = u.constant(-cval(in.a));
+                    in.op = Op::Copy;
+                    ++stats.folded; changed = true;
+                }
+                else if (definesDst(in.op) && readsB(in.op) && isConst(in.a) && isConst(in.b) && !mayTrap(in)) {
+                    double a = cval(in.a), b = cval(in.b), r = 0.0;
+                    switch (in.op) {
+                    case Op::Add: r = a + b; break;
+                    case Op::Sub: r = a - b; break;
+                    case Op::Mul: r = a * b; break;
+                    case Op::Div: r = a / b; break;
+                    case Op::Mod: r = std::fmod(a, b); break;
+                    default: break;
+                    }
+                    if (exactText(r, u.digits)) {
+                        in.op = Op::Copy;
+                        in.a = u.constant(r);
+                        in.b = {};
+                        ++stats.folded; changed = true;
+                    }
+                }
+                else if (((in.op == Op::IfRel || in.op == Op::IfFalseRel) && isConst(in.a) && isConst(in.b)) ||
+                    ((in.op == Op::If || in.op == Op::IfFalse) && isConst(in.a))) {
+                    bool taken = in.op == Op::IfRel ? foldRel(in.rel, cval(in.a), cval(in.b)) != 0.0
+                        : in.op == Op::IfFalseRel ? foldRel(in.rel, cval(in.a), cval(in.b)) == 0.0
+                        : in.op == Op::If ? cval(in.a) != 0.0 : cval(in.a) == 0.0;
+                    if (taken) { in.op = Op::Goto; in.a = in.b = {}; }
+                    else drop[i] = 1;
+                    ++stats.folded; changed = true;
+                    if (!taken) continue;
+                }
+
+                if (definesDst(in.op)) {
+                    kill(in.dst);
+                    if (in.op == Op::Copy && in.a != in.dst) {
+                        known[key(in.dst)] = in.a;
+                        if (isName(in.a)) users[key(in.a)].push_back(key(in.dst));
+                    }
+                }
+                if (isJump(in.op)) { known.clear(); users.clear(); }
+            }
+            compact(drop);
+            return changed;
+        }
+
+        // "tN = a op b; x = tN" -> "x = a op b",  tN    
+        bool coalesce() {
+            std::vector<std::uint32_t> defs(keys(), 0), uses(keys(), 0);
+            for (auto& in : u.code) {
+                if (definesDst(in.op)) ++defs[key(in.dst)];
+                if (readsA(in.op) && isName(in.a)) ++uses[key(in.a)];
+                if (readsB(in.op) && isName(in.b)) ++uses[key(in.b)];
+            }
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            for (std::size_t i = 0; i + 1 < u.code.size(); ++i) {
+                Instr& in = u.code[i];
+                Instr& next = u.code[i + 1];
+                if (!definesDst(in.op) || in.dst.kind != Operand::Kind::Temp) continue;
+                if (next.op != Op::Copy || next.a != in.dst || drop[i]) continue;
+                auto k = key(in.dst);
+                if (defs[k] != 1 || uses[k] != 1) continue;
+                in.dst = next.dst;
+                drop[i + 1] = 1;
+                ++stats.coalesced;
+                changed = true;
+            }
+            compact(drop);
+            return changed;
+        }
+
+        // ---------- control flow ----------
+        bool cleanFlow() {
+            bool changed = false;
+            for (bool again = true; again;) {
+                again = mergeLabels();
+                again = thread() || again;
+                again = invert() || again;
+                again = dropJumps() || again;
+                again = dropUnreachable() || again;
+                changed = changed || again;
+            }
+            return changed;
+        }
+
+        //   -> ;    
+        bool mergeLabels() {
+            std::unordered_map<std::uint32_t, std::uint32_t> alias;
+            for (std::size_t i = 1; i < u.code.size(); ++i) {
+                if (u.code[i].op != Op::Label || u.code[i - 1].op != Op::Label) continue;
+                auto head = u.code[i - 1].label;
+                auto f = alias.find(head);
+                alias[u.code[i].label] = f == alias.end() ? head : f->second;
+            }
+            std::unordered_map<std::uint32_t, std::size_t> refs;
+            for (auto& in : u.code) {
+                if (!isJump(in.op)) continue;
+                auto f = alias.find(in.label);
+                if (f != alias.end()) in.label = f->second;
+                ++refs[in.label];
+            }
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            for (std::size_t i = 0; i < u.code.size(); ++i) {
+                auto& in = u.code[i];
+                if (in.op != Op::Label || (!alias.count(in.label) && refs.count(in.label))) continue;
+                drop[i] = 1; ++stats.labels; changed = true;
+            }
+            compact(drop);
+            return changed;
+        }
+
+        std::unordered_map<std::uint32_t, std::size_t> labelPos() const {
+            std::unordered_map<std::uint32_t, std::size_t> at;
+            for (std::size_t i = 0; i < u.code.size(); ++i)
+                if (u.code[i].op == Op::Label) at[u.code[i].label] = i;
+            return at;
+        }
+
+        //   ,    "goto M",    M
+        bool thread() {
+            auto at = labelPos();
+            bool changed = false;
+            for (auto& in : u.code) {
+                if (!isJump(in.op)) continue;
+                auto target = in.label;
+                for (int hops = 0; hops < 64; ++hops) {
+                    auto f = at.find(target);
+                    if (f == at.end()) break;
+                    auto j = CFG::firstReal(u.code, f->second);
+                    if (j >= u.code.size() || u.code[j].op != Op::Goto || u.code[j].label == target) break;
+                    target = u.code[j].label;
+                }
+                if (target != in.label) { in.label = target; ++stats.threaded; changed = true; }
+            }
+            return changed;
+        }
+
+        //    l      i
+        bool labelFollows(std::size_t i, std::uint32_t l) const {
+            for (std::size_t j = i + 1; j < u.code.size() && u.code[j].op == Op::Label; ++j)
+                if (u.code[j].label == l) return true;
+            return false;
+        }
+
+        // ==  !=  ;  <, <= ...  NaN  ifFalse
+        static bool invertCond(Instr& in) {
+            switch (in.op) {
+            case Op::If: in.op = Op::IfFalse; return true;
+            case Op::IfFalse: in.op = Op::If; return true;
+            case Op::IfFalseRel: in.op = Op::IfRel; return true;
+            case Op::IfRel:
+                if (in.rel == Rel::EQ) in.rel = Rel::NE;
+                else if (in.rel == Rel::NE) in.rel = Rel::EQ;
+                else in.op = Op::IfFalseRel;
+                return true;
+            default: return false;
+            }
+        }
+
+        bool invert() {
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            for (std::size_t i = 0; i + 1 < u.code.size(); ++i) {
+                Instr& in = u.code[i];
+                const Instr& next = u.code[i + 1];
+                if (drop[i] || !isJump(in.op) || in.op == Op::Goto || next.op != Op::Goto) continue;
+                if (!labelFollows(i + 1, in.label)) continue;
+                invertCond(in);
+                in.label = next.label;
+                drop[i + 1] = 1;
+                ++stats.inverted; changed = true;
+            }
+            compact(drop);
+            return changed;
+        }
+
+        //   ,      (    )
+        bool dropJumps() {
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            for (std::size_t i = 0; i < u.code.size(); ++i) {
+                if (!isJump(u.code[i].op) || !labelFollows(i, u.code[i].label)) continue;
+                drop[i] = 1; ++stats.jumps; changed = true;
+            }
+            compact(drop);
+            return changed;
+        }
+
+        bool dropUnreachable() {
+            CFG cfg(u);
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            for (auto& b : cfg.blocks) {
+                if (b.reachable) continue;
+                for (auto i = b.begin; i < b.end; ++i) { drop[i] = 1; ++stats.unreachable; changed = true; }
+            }
+            compact(drop);
+            return changed;
+        }
+
+        //   :   goto/fall-through 
+        //   ,    . ,  
+        //   .
+        bool reorder() {
+            CFG cfg(u);
+            auto& bs = cfg.blocks;
+            const std::size_t n = bs.size();
+            if (n < 3) return false;
+
+            auto last = [&](std::size_t b) -> const Instr* {
+                return bs[b].end > bs[b].begin ? &u.code[bs[b].end - 1] : nullptr;
+            };
+            auto target = [&](std::size_t b) -> std::size_t {
+                auto in = last(b);
+                if (!in || !isJump(in->op)) return n;
+                auto f = cfg.blockOf.find(in->label);
+                return f == cfg.blockOf.end() ? n : f->second;
+            };
+            auto fall = [&](std::size_t b) -> std::size_t {
+                auto in = last(b);
+                if (in && in->op == Op::Goto) return n;
+                return b + 1 < n ? b + 1 : n;
+            };
+
+            std::vector<std::size_t> order;
+            std::vector<char> placed(n, 0);
+            for (std::size_t seed = 0; seed < n; ++seed) {
+                for (auto cur = seed; cur < n && !placed[cur];) {
+                    placed[cur] = 1;
+                    order.push_back(cur);
+                    auto in = last(cur);
+                    auto t = target(cur), f = fall(cur);
+                    if (in && in->op == Op::Goto) cur = t;
+                    else if (f < n && !placed[f]) cur = f;
+                    else if (in && isJump(in->op) && t < n && f < n) cur = t; //  
+                    else break;
+                }
+            }
+
+            // ̳    (,    )
+            std::vector<std::uint32_t> head(n, 0);
+            for (std::size_t b = 0; b < n; ++b)
+                if (bs[b].begin < bs[b].end && u.code[bs[b].begin].op == Op::Label) head[b] = u.code[bs[b].begin].label;
+            auto labelOf = [&](std::size_t b) { if (!head[b]) head[b] = ++u.labels; return head[b]; };
+            std::uint32_t endLabel = 0;
+
+            //      ,   ' 
+            std::vector<Instr> out;
+            for (int pass = 0; pass < 2; ++pass) {
+                out.clear();
+                out.reserve(u.code.size() + n);
+                auto jumpTo = [&](std::uint32_t l) { Instr g; g.op = Op::Goto; g.label = l; out.push_back(g); };
+                for (std::size_t p = 0; p < n; ++p) {
+                    auto b = order[p];
+                    auto nb = p + 1 < n ? order[p + 1] : n;
+                    if (bs[b].begin < bs[b].end && u.code[bs[b].begin].op != Op::Label && head[b]) {
+                        Instr l; l.op = Op::Label; l.label = head[b]; out.push_back(l);
+                    }
+                    auto in = last(b);
+                    bool jump = in && isJump(in->op);
+                    std::size_t body = jump ? bs[b].end - 1 : bs[b].end;
+                    out.insert(out.end(), u.code.begin() + bs[b].begin, u.code.begin() + body);
+                    auto f = fall(b), t = target(b);
+
+                    if (jump && in->op == Op::Goto) {
+                        if (t != nb) out.push_back(*in);
+                        continue;
+                    }
+                    if (jump) {
+                        Instr c = *in;
+                        if (f < n && f != nb && t == nb) { invertCond(c); c.label = labelOf(f); out.push_back(c); continue; }
+                        out.push_back(c);
+                    }
+                    if (f < n && f != nb) jumpTo(labelOf(f));
+                    else if (f == n && nb != n) {
+                        if (!endLabel) endLabel = ++u.labels;
+                        jumpTo(endLabel);
+                    }
+                }
+                if (endLabel) { Instr l; l.op = Op::Label; l.label = endLabel; out.push_back(l); }
+            }
+
+            auto jumps = [](const std::vector<Instr>& code) {
+                std::size_t k = 0;
+                for (auto& in : code) k += isJump(in.op);
+                return k;
+            };
+            std::size_t before = jumps(u.code), after = jumps(out);
+            if (after >= before) return false;
+            stats.reordered += before - after;
+            u.code.swap(out);
+            return true;
+        }
+
+        // ---------- liveness + dead stores ----------
+        bool eliminate() {
+            CFG cfg(u);
+            auto& bs = cfg.blocks;
+            Liveness lv(u, cfg);
+            std::vector<char> mark(keys(), 0);
+
+            bool changed = false;
+            std::vector<char> drop(u.code.size(), 0);
+            std::vector<std::uint32_t> touched;
+            auto live = [&](std::uint32_t k) { if (!mark[k]) { mark[k] = 1; touched.push_back(k); } };
+            for (std::size_t b = 0; b < bs.size(); ++b) {
+                for (auto k : lv.out[b]) live(k);
+                for (std::size_t i = bs[b].end; i-- > bs[b].begin;) {
+                    const Instr& ins = u.code[i];
+                    if (definesDst(ins.op)) {
+                        auto k = key(ins.dst);
+                        bool self = ins.op == Op::Copy && ins.a == ins.dst;
+                        if ((!mark[k] || self) && !mayTrap(ins)) { drop[i] = 1; ++stats.dead; changed = true; continue; }
+                        mark[k] = 0;
+                    }
+                    if (readsA(ins.op) && isName(ins.a)) live(key(ins.a));
+                    if (readsB(ins.op) && isName(ins.b)) live(key(ins.b));
+                }
+                for (auto k : touched) mark[k] = 0;
+                touched.clear();
+            }
+            compact(drop);
+            return changed;
+        }
+    };
+
+} // namespace TAC
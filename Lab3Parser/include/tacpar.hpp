@@ -0,0 +1,138 @@
+// include/tacpar.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "tac.hpp"
+#include "pool.hpp"
+
+namespace TAC {
+
+    //  :  Block::items     ,
+    //     tN/Ln.      ,
+    //          Emitter.
+    struct ParallelEmitter {
+        const DAG::Graph* dag = nullptr;
+        unsigned threads = 0;       // 0    
+        IO::Digits digits = IO::Digits::Twelve;
+        std::size_t emitted = 0;
+
+        //         
+        static constexpr std::size_t minItems = 64;
+
+        // false   ,   (     )  
+        // ( a_N    ),   Emitter
+        bool gen(const AST::Block* root) {
+            workers = Pool::threads(threads);
+            const auto items = root->items.size();
+            if (workers <= 1 || items < 2 * minItems) return false;
+            for (auto& it : root->items)
+                if (!plain(it.get())) return false;
+
+            plan.plan(root);
+            auto count = std::min<std::size_t>(static_cast<std::size_t>(workers) * 8, items / minItems);
+            chunks.clear();
+            chunks.resize(count);
+            Pool::forEach(count, workers, [&](std::size_t i) {
+                auto& c = chunks[i];
+                c.em.dag = dag;
+                c.em.unit.digits = digits;
+                c.em.genItems(root, items * i / count, items * (i + 1) / count, plan);
+            });
+
+            std::uint32_t t = 0, l = 0;
+            emitted = 0;
+            for (auto& c : chunks) {
+                c.tempBase = t; c.labelBase = l;
+                t += c.em.unit.temps; l += c.em.unit.labels;
+                emitted += c.em.emitted;
+            }
+            temps = t; labels = l;
+            Pool::forEach(count, workers, [&](std::size_t i) { renumber(chunks[i]); });
+            return true;
+        }
+
+        void write(IO::Writer& out) {
+            Pool::forEach(chunks.size(), workers, [&](std::size_t i) {
+                auto& c = chunks[i];
+                for (auto& in : c.em.unit.code) {
+                    c.em.unit.render(c.text, in);
+                    c.text += '\n';
+                }
+            });
+            for (auto& c : chunks) {
+                out.write(c.text.data(), c.text.size());
+                std::string().swap(c.text);
+            }
+        }
+
+        //  Unit,   Emitter::gen:     
+        Unit merge() {
+            Unit u;
+            u.digits = digits;
+            std::vector<std::uint32_t> vmap, cmap;
+            for (auto& c : chunks) {
+                auto& cu = c.em.unit;
+                vmap.resize(cu.vars.size());
+                cmap.resize(cu.consts.size());
+                std::fill(vmap.begin(), vmap.end(), none);
+                std::fill(cmap.begin(), cmap.end(), none);
+                auto remap = [&](Operand& o) {
+                    if (o.kind == Operand::Kind::Var) {
+                        if (vmap[o.index] == none) vmap[o.index] = u.var(cu.vars[o.index]).index;
+                        o.index = vmap[o.index];
+                    }
+                    else if (o.kind == Operand::Kind::Const) {
+                        if (cmap[o.index] == none) cmap[o.index] = u.constant(cu.consts[o.index]).index;
+                        o.index = cmap[o.index];
+                    }
+                };
+                for (auto in : cu.code) {
+                    remap(in.dst); remap(in.a); remap(in.b);
+                    u.code.push_back(in);
+                }
+                std::vector<Instr>().swap(cu.code);
+            }
+            u.temps = temps;
+            u.labels = labels;
+            return u;
+        }
+
+    private:
+        static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+        //     ;     
+        static bool plain(const AST::Stmt* s) {
+            using namespace AST;
+            if (dynamic_cast<const Function*>(s) || dynamic_cast<const ArrayDecl*>(s)) return false;
+            if (auto b = dynamic_cast<const Block*>(s)) {
+                for (auto& it : b->items) if (!plain(it.get())) return false;
+                return true;
+            }
+            if (auto i = dynamic_cast<const AST::If*>(s)) return plain(i->thenS.get()) && (!i->elseS || plain(i->elseS.get()));
+            if (auto w = dynamic_cast<const AST::While*>(s)) return plain(w->body.get());
+            return true;
+        }
+
+        struct Chunk {
+            Emitter em;
+            std::uint32_t tempBase = 0, labelBase = 0;
+            std::string text;
+        };
+
+        Renames plan;
+        std::vector<Chunk> chunks;
+        unsigned workers = 1;
+        std::uint32_t temps = 0, labels = 0;
+
+        static void renumber(Chunk& c) {
+            for (auto& in : c.em.unit.code) {
+                for (Operand* o : { &in.dst, &in.a, &in.b })
+                    if (o->kind == Operand::Kind::Temp) o->index += c.tempBase;
+                if (in.op == Op::Label || isJump(in.op)) in.label += c.labelBase;
+            }
+        }
+    };
+
+} // namespace TAC
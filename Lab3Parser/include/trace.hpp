@@ -0,0 +1,70 @@
+// include/trace.hpp
+#pragma once
+#include <exception>
+#include <string>
+
+namespace AST { struct Stmt; }
+
+//   . Context  ,   
+//   ;  NoTrace    inline,   Context    ,
+//    . Recorder  䳿  Sink,   .
+namespace Trace {
+
+    enum class Kind : unsigned char { Enter, Exit, Read, Write, Declare, Print };
+
+    struct Event {
+        Kind kind;
+        const AST::Stmt* stmt = nullptr;   // Enter/Exit
+        const std::string* name = nullptr; // Read/Write/Declare
+        double value = 0.0;                // Read/Write/Declare/Print
+    };
+
+    struct Sink {
+        virtual ~Sink() = default;
+        virtual void event(const Event& e) = 0;
+    };
+
+    struct NoTrace {
+        static constexpr bool enabled = false;
+        void enter(const AST::Stmt&) {}
+        void exit(const AST::Stmt&) {}
+        void read(const std::string&, double) {}
+        void write(const std::string&, double) {}
+        void declare(const std::string&, double) {}
+        void print(double) {}
+    };
+
+    struct Recorder {
+        static constexpr bool enabled = true;
+        Sink* sink = nullptr;
+
+        void enter(const AST::Stmt& s) { emit({ Kind::Enter, &s, nullptr, 0.0 }); }
+        void exit(const AST::Stmt& s) { emit({ Kind::Exit, &s, nullptr, 0.0 }); }
+        void read(const std::string& n, double v) { emit({ Kind::Read, nullptr, &n, v }); }
+        void write(const std::string& n, double v) { emit({ Kind::Write, nullptr, &n, v }); }
+        void declare(const std::string& n, double v) { emit({ Kind::Declare, nullptr, &n, v }); }
+        void print(double v) { emit({ Kind::Print, nullptr, nullptr, v }); }
+
+    private:
+        void emit(const Event& e) { if (sink) sink->event(e); }
+    };
+
+    // Enter  , Exit  :    ,  
+    //  (return  ,  ).  Sink    .
+    template<class C>
+    struct Scope {
+        C& ctx;
+        const AST::Stmt& stmt;
+        const int unwinding = std::uncaught_exceptions();
+
+        Scope(C& c, const AST::Stmt& s) : ctx(c), stmt(s) { ctx.enter(stmt); }
+        ~Scope() noexcept(false) {
+            if (std::uncaught_exceptions() == unwinding) { ctx.exit(stmt); return; }
+            try { ctx.exit(stmt); }
+            catch (...) {}
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+} // namespace Trace
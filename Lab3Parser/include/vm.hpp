@@ -0,0 +1,276 @@
+// include/vm.hpp
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "tac.hpp"
+
+namespace VM {
+
+    //    TAC: ,   tN   
+    // ,     
+    enum class Op : std::uint8_t {
+        Mov, Neg, Add, Sub, Mul, Div, Mod,
+        Lt, Le, Gt, Ge, Eq, Ne,         // if a rel b goto d
+        NLt, NLe, NGt, NGe, NEq, NNe,   // ifFalse a rel b goto d (NaN -> )
+        Jnz, Jz, Jmp,
+        Print,
+        Param, Call, Ret,               // call: a   
+        Load, LoadU, Store, StoreU,     // load: d = m[a], b  ; store: m[a] = b, d  
+        Zero,                           // d  
+        Step,                           //   maxSteps
+        Halt
+    };
+
+    struct Instr {
+        Op op = Op::Halt;
+        std::uint32_t d = 0, a = 0, b = 0; //   d  
+    };
+
+    //       :    ( f.*  tN
+    //  )      ret,       
+    struct Function {
+        std::uint32_t entry = 0;
+        std::vector<std::uint32_t> params, saved;
+    };
+
+    //     ';   (LoadU/StoreU)      
+    struct Array {
+        std::uint32_t offset = 0, size = 0;
+        std::string name;
+    };
+
+    struct Program {
+        std::vector<Instr> code;
+        std::vector<double> init; //  : ,  
+        std::vector<Function> funcs;
+        std::vector<Array> arrays;
+        std::size_t memory = 0; //    
+
+        // : [][][t0..tN]
+        static Program compile(const TAC::Unit& u) {
+            using TAC::Operand;
+            const auto nc = static_cast<std::uint32_t>(u.consts.size());
+            const auto nv = static_cast<std::uint32_t>(u.vars.size());
+            auto reg = [&](const Operand& o) -> std::uint32_t {
+                switch (o.kind) {
+                case Operand::Kind::Const: return o.index;
+                case Operand::Kind::Var: return nc + o.index;
+                case Operand::Kind::Temp: return nc + nv + o.index;
+                default: return 0;
+                }
+            };
+
+            Program p;
+            p.init.assign(nc + nv + u.temps + 1, 0.0);
+            for (std::uint32_t i = 0; i < nc; ++i) p.init[i] = u.consts[i];
+
+            // ̳       ; func  Halt,   
+            std::vector<std::uint32_t> at(u.labels + 1, 0);
+            std::uint32_t pc = 0;
+            p.funcs.resize(u.functions.size());
+            for (auto& in : u.code) {
+                if (in.op == TAC::Op::Label) at[in.label] = pc;
+                else {
+                    if (in.op == TAC::Op::Func) p.funcs[in.label].entry = pc + 1;
+                    ++pc;
+                }
+            }
+            if (!u.functions.empty()) saveSets(u, p, reg);
+            for (auto& a : u.arrays) {
+                if (p.memory + a.size > 0xFFFFFFFFull) throw std::runtime_error("arrays are too large for the VM");
+                p.arrays.push_back({ static_cast<std::uint32_t>(p.memory), a.size, a.name });
+                p.memory += a.size;
+            }
+
+            p.code.reserve(pc + 1);
+            for (auto& in : u.code) {
+                Instr x;
+                x.a = reg(in.a);
+                x.b = reg(in.b);
+                x.d = TAC::isJump(in.op) ? at[in.label] : reg(in.dst);
+                switch (in.op) {
+                case TAC::Op::Label: continue;
+                case TAC::Op::Copy: x.op = Op::Mov; break;
+                case TAC::Op::Neg: x.op = Op::Neg; break;
+                case TAC::Op::Add: x.op = Op::Add; break;
+                case TAC::Op::Sub: x.op = Op::Sub; break;
+                case TAC::Op::Mul: x.op = Op::Mul; break;
+                case TAC::Op::Div: x.op = Op::Div; break;
+                case TAC::Op::Mod: x.op = Op::Mod; break;
+                case TAC::Op::IfRel:
+                    x.op = static_cast<Op>(static_cast<int>(Op::Lt) + static_cast<int>(in.rel));
+                    break;
+                case TAC::Op::IfFalseRel:
+                    x.op = static_cast<Op>(static_cast<int>(Op::NLt) + static_cast<int>(in.rel));
+                    break;
+                case TAC::Op::If: x.op = Op::Jnz; break;
+                case TAC::Op::IfFalse: x.op = Op::Jz; break;
+                case TAC::Op::Goto: x.op = Op::Jmp; break;
+                case TAC::Op::Print: x.op = Op::Print; break;
+                case TAC::Op::Param: x.op = Op::Param; break;
+                case TAC::Op::Call: x.op = Op::Call; x.a = in.label; break;
+                case TAC::Op::Return: x.op = Op::Ret; break;
+                case TAC::Op::Func: x.op = Op::Halt; break;
+                case TAC::Op::Load:
+                    x.op = in.unchecked ? Op::LoadU : Op::Load;
+                    x.b = in.unchecked ? p.arrays[in.label].offset : in.label;
+                    break;
+                case TAC::Op::Store:
+                    x.op = in.unchecked ? Op::StoreU : Op::Store;
+                    x.d = in.unchecked ? p.arrays[in.label].offset : in.label;
+                    break;
+                case TAC::Op::Array: x.op = Op::Zero; x.d = in.label; break;
+                case TAC::Op::Step: x.op = Op::Step; break;
+                }
+                p.code.push_back(x);
+            }
+            p.code.push_back(Instr{}); // Halt
+            return p;
+        }
+
+    private:
+        //   : ,    "f."  tN,     
+        template<class Reg>
+        static void saveSets(const TAC::Unit& u, Program& p, Reg& reg) {
+            using TAC::Operand;
+            std::vector<std::uint32_t> seen(p.init.size(), 0); //   + 1
+            std::size_t cur = 0;
+            auto mark = [&](const Operand& o) {
+                if (!cur) return;
+                bool mine = o.kind == Operand::Kind::Temp;
+                if (o.kind == Operand::Kind::Var) {
+                    auto& name = u.vars[o.index];
+                    auto& fn = u.functions[cur - 1].name;
+                    mine = name.size() > fn.size() && name.compare(0, fn.size(), fn) == 0 && name[fn.size()] == '.';
+                }
+                if (!mine) return;
+                auto r = reg(o);
+                if (seen[r] == cur) return;
+                seen[r] = static_cast<std::uint32_t>(cur);
+                p.funcs[cur - 1].saved.push_back(r);
+            };
+            for (auto& in : u.code) {
+                if (in.op == TAC::Op::Func) {
+                    cur = in.label + 1;
+                    auto& f = p.funcs[in.label];
+                    for (auto& o : u.functions[in.label].params) { f.params.push_back(reg(o)); mark(o); }
+                    continue;
+                }
+                mark(in.dst); mark(in.a); mark(in.b);
+            }
+        }
+    };
+
+    //    AST::Print;     ,    Binary::eval.
+    // maxSteps   step,  Emitter::steps  ,    Context::step:
+    //         .   step   .
+    inline void run(const Program& p, std::vector<double>& regs, std::ostream& out, std::uint64_t maxSteps = 0,
+        IO::Digits digits = IO::Digits::Twelve) {
+        regs = p.init;
+        double* r = regs.data();
+        const Instr* code = p.code.data();
+        std::uint32_t pc = 0;
+        std::uint64_t steps = 0;
+        //      ,  
+        struct Frame { std::uint32_t ret, dst, fn; std::size_t base; };
+        std::vector<Frame> calls;
+        std::vector<double> args, saved;
+        if (!p.funcs.empty()) { calls.reserve(64); args.reserve(16); saved.reserve(AST::framePool); }
+        std::vector<double> mem(p.memory, 0.0);
+        double* m = mem.data();
+        //    ,  BasicContext::at
+        auto at = [&](std::uint32_t arr, double i) {
+            const Array& a = p.arrays[arr];
+            if (!(i >= 0.0 && i < static_cast<double>(a.size))) throw std::runtime_error("index out of range: " + a.name);
+            return a.offset + static_cast<std::size_t>(i);
+        };
+        auto jump = [&](std::uint32_t to) { pc = to; };
+        for (;;) {
+            const Instr& in = code[pc++];
+            switch (in.op) {
+            case Op::Mov: r[in.d] = r[in.a]; break;
+            case Op::Neg: r[in.d] = -r[in.a]; break;
+            case Op::Add: r[in.d] = r[in.a] + r[in.b]; break;
+            case Op::Sub: r[in.d] = r[in.a] - r[in.b]; break;
+            case Op::Mul: r[in.d] = r[in.a] * r[in.b]; break;
+            case Op::Div:
+                if (r[in.b] == 0.0) throw std::runtime_error("division by zero");
+                r[in.d] = r[in.a] / r[in.b];
+                break;
+            case Op::Mod: r[in.d] = std::fmod(r[in.a], r[in.b]); break;
+            case Op::Lt: if (r[in.a] < r[in.b]) jump(in.d); break;
+            case Op::Le: if (r[in.a] <= r[in.b]) jump(in.d); break;
+            case Op::Gt: if (r[in.a] > r[in.b]) jump(in.d); break;
+            case Op::Ge: if (r[in.a] >= r[in.b]) jump(in.d); break;
+            case Op::Eq: if (r[in.a] == r[in.b]) jump(in.d); break;
+            case Op::Ne: if (r[in.a] != r[in.b]) jump(in.d); break;
+            case Op::NLt: if (!(r[in.a] < r[in.b])) jump(in.d); break;
+            case Op::NLe: if (!(r[in.a] <= r[in.b])) jump(in.d); break;
+            case Op::NGt: if (!(r[in.a] > r[in.b])) jump(in.d); break;
+            case Op::NGe: if (!(r[in.a] >= r[in.b])) jump(in.d); break;
+            case Op::NEq: if (!(r[in.a] == r[in.b])) jump(in.d); break;
+            case Op::NNe: if (!(r[in.a] != r[in.b])) jump(in.d); break;
+            case Op::Jnz: if (r[in.a] != 0.0) jump(in.d); break;
+            case Op::Jz: if (r[in.a] == 0.0) jump(in.d); break;
+            case Op::Jmp: jump(in.d); break;
+            case Op::Print: {
+                char tmp[IO::numberChars + 1];
+                std::size_t n = IO::formatNumber(tmp, r[in.a], digits);
+                tmp[n++] = '\n';
+                out.write(tmp, static_cast<std::streamsize>(n));
+                break;
+            }
+            case Op::Param: args.push_back(r[in.a]); break;
+            case Op::Step:
+                if (maxSteps && ++steps > maxSteps) throw std::runtime_error("step limit exceeded");
+                break;
+            case Op::Call: {
+                if (calls.size() >= AST::maxCallDepth) throw std::runtime_error("call depth exceeded");
+                const Function& f = p.funcs[in.a];
+                if (args.size() < f.params.size()) throw std::runtime_error("call without params");
+                std::size_t base = saved.size();
+                for (auto s : f.saved) saved.push_back(r[s]);
+                calls.push_back({ pc, in.d, in.a, base });
+                std::size_t a0 = args.size() - f.params.size();
+                for (std::size_t i = 0; i < f.params.size(); ++i) r[f.params[i]] = args[a0 + i];
+                args.resize(a0);
+                pc = f.entry;
+                break;
+            }
+            case Op::Ret: {
+                if (calls.empty()) return;
+                double v = r[in.a];
+                Frame fr = calls.back();
+                calls.pop_back();
+                const Function& f = p.funcs[fr.fn];
+                for (std::size_t k = 0; k < f.saved.size(); ++k) r[f.saved[k]] = saved[fr.base + k];
+                saved.resize(fr.base);
+                r[fr.dst] = v;
+                pc = fr.ret;
+                break;
+            }
+            case Op::Load: r[in.d] = m[at(in.b, r[in.a])]; break;
+            case Op::LoadU: r[in.d] = m[in.b + static_cast<std::size_t>(r[in.a])]; break;
+            case Op::Store: m[at(in.d, r[in.a])] = r[in.b]; break;
+            case Op::StoreU: m[in.d + static_cast<std::size_t>(r[in.a])] = r[in.b]; break;
+            case Op::Zero: {
+                const Array& a = p.arrays[in.d];
+                std::fill(m + a.offset, m + a.offset + a.size, 0.0);
+                break;
+            }
+            case Op::Halt: return;
+            }
+        }
+    }
+
+    inline void run(const Program& p, std::ostream& out, std::uint64_t maxSteps = 0, IO::Digits digits = IO::Digits::Twelve) {
+        std::vector<double> regs;
+        run(p, regs, out, maxSteps, digits);
+    }
+
+} // namespace VM
@@ -0,0 +1,70 @@
+// include/writer.hpp
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <charconv>
+#include "numfmt.hpp"
+
+namespace IO {
+
+    //     .dot/TAC:    
+    //   <<      (setprecision )
+    struct Writer {
+        explicit Writer(FILE* f, std::size_t cap = 1u << 20) : file(f) { buf.reserve(cap); }
+        explicit Writer(std::ostream& os, std::size_t cap = 1u << 20) : stream(&os) { buf.reserve(cap); }
+        ~Writer() { flush(); }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        void write(const char* p, std::size_t n) {
+            if (buf.size() + n > buf.capacity()) {
+                flush();
+                if (n > buf.capacity()) { sink(p, n); return; }
+            }
+            buf.insert(buf.end(), p, p + n);
+        }
+
+        Writer& operator<<(const char* s) { write(s, std::strlen(s)); return *this; }
+        Writer& operator<<(const std::string& s) { write(s.data(), s.size()); return *this; }
+        Writer& operator<<(char c) { write(&c, 1); return *this; }
+        Writer& operator<<(int v) {
+            char tmp[16];
+            auto r = std::to_chars(tmp, tmp + sizeof tmp, v);
+            write(tmp, static_cast<std::size_t>(r.ptr - tmp));
+            return *this;
+        }
+        //  std::setprecision(12)   ,   (digits)
+        Writer& operator<<(double v) {
+            char tmp[numberChars];
+            write(tmp, formatNumber(tmp, v, digits));
+            return *this;
+        }
+
+        Digits digits = Digits::Twelve;
+
+        bool flush() {
+            if (!buf.empty()) { sink(buf.data(), buf.size()); buf.clear(); }
+            if (file) { if (std::fflush(file) != 0) failed = true; }
+            else if (stream) { stream->flush(); if (!*stream) failed = true; }
+            return !failed;
+        }
+
+        bool ok() const { return !failed; }
+
+    private:
+        FILE* file = nullptr;
+        std::ostream* stream = nullptr;
+        std::vector<char> buf;
+        bool failed = false;
+
+        void sink(const char* p, std::size_t n) {
+            if (file) { if (std::fwrite(p, 1, n, file) != n) failed = true; }
+            else if (stream) { stream->write(p, static_cast<std::streamsize>(n)); if (!*stream) failed = true; }
+        }
+    };
+
+} // namespace IO
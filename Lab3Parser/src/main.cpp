@@ -1,95 +1,1049 @@
 // src/main.cpp
 #include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <string>
-#include "../include/ast.hpp"
+#include <vector>
+#include <streambuf>
+#include <sstream>
+#include <mutex>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include "../include/lab3.hpp"
 #include "../include/tac.hpp"
+#include "../include/tacpar.hpp"
+#include "../include/tacopt.hpp"
+#include "../include/ssa.hpp"
+#include "../include/regalloc.hpp"
+#include "../include/dag.hpp"
+#include "../include/astcache.hpp"
+#include "../include/memo.hpp"
+#include "../include/tacload.hpp"
+#include "../include/vm.hpp"
+#include "../include/aot.hpp"
+#include "../include/pool.hpp"
+#include "../include/server.hpp"
+#include "../include/memstats.hpp"
+#include "../include/perfcount.hpp"
+#include "../include/regress.hpp"
+#include "../include/selftest.hpp"
 
-// ,   Flex/Bison
-extern int yyparse(void);
-extern int yylex_destroy(void);
-extern FILE* yyin;
+//   --mem-stats:  operator new/delete    Mem
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // free()      malloc()  operator new
+#endif
+void* operator new(std::size_t n) {
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    Mem::allocated(p);
+    return p;
+}
+void* operator new[](std::size_t n) { return ::operator new(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    void* p = std::malloc(n ? n : 1);
+    Mem::allocated(p);
+    return p;
+}
+void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept { return ::operator new(n, t); }
+void operator delete(void* p) noexcept { Mem::freed(p); std::free(p); }
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { ::operator delete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { ::operator delete(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
-//   AST,   parser.y
-extern AST::Block* g_root;
+static std::string readAll(FILE* f) {
+    std::string s;
+    char buf[65536];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof buf, f)) > 0) s.append(buf, n);
+    return s;
+}
 
-int main(int argc, char* argv[]) {
+//     --bench:   ,  
+struct NullBuf : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+// --trace: 䳿  ,   
+struct TraceText : Trace::Sink {
+    std::ostream& out;
+    int depth = 0;
+    explicit TraceText(std::ostream& os) : out(os) {}
+
+    static const char* kind(const AST::Stmt* s) {
+        if (dynamic_cast<const AST::Block*>(s)) return "Block";
+        if (dynamic_cast<const AST::VarDecl*>(s)) return "VarDecl";
+        if (dynamic_cast<const AST::Assign*>(s)) return "Assign";
+        if (dynamic_cast<const AST::Print*>(s)) return "Print";
+        if (dynamic_cast<const AST::If*>(s)) return "If";
+        if (dynamic_cast<const AST::While*>(s)) return "While";
+        if (dynamic_cast<const AST::Function*>(s)) return "Function";
+        if (dynamic_cast<const AST::Return*>(s)) return "Return";
+        if (dynamic_cast<const AST::ExprStmt*>(s)) return "ExprStmt";
+        if (dynamic_cast<const AST::ArrayDecl*>(s)) return "ArrayDecl";
+        if (dynamic_cast<const AST::IndexAssign*>(s)) return "IndexAssign";
+        return "Stmt";
+    }
+
+    void event(const Trace::Event& e) override {
+        if (e.kind == Trace::Kind::Exit) --depth;
+        std::string line(static_cast<std::size_t>(2 * depth), ' ');
+        switch (e.kind) {
+        case Trace::Kind::Enter: line += "enter "; line += kind(e.stmt); ++depth; break;
+        case Trace::Kind::Exit: line += "exit "; line += kind(e.stmt); break;
+        case Trace::Kind::Read: line += "read " + *e.name + " = "; break;
+        case Trace::Kind::Write: line += "write " + *e.name + " = "; break;
+        case Trace::Kind::Declare: line += "declare " + *e.name + " = "; break;
+        case Trace::Kind::Print: line += "print "; break;
+        }
+        if (e.kind != Trace::Kind::Enter && e.kind != Trace::Kind::Exit) IO::appendNumber(line, e.value, IO::Digits::Shortest);
+        line += '\n';
+        out << "trace: " << line;
+    }
+};
+
+struct Options {
     bool emitDot = false;
     bool emitTac = false;
+    bool useDag = false;
+    bool useCache = false;   // --cache: AST  cacheDir  
+    bool memo = false;       // --memo:        
+    bool memoErrors = false; // --memo-errors:      
+    bool noMemo = false;     // --no-memo:      --memo
+    bool timing = false;
+    bool toStdout = false;
+    bool memStats = false;
+    bool runExec = false; //   ( --ast/--tac  )
+    bool tacExplicit = false;
+    std::string dotPath = "ast.dot", tacPath = "tac.txt"; // "-"  stdout
+    bool tacOpt = false;
+    bool useSsa = false;
+    bool ssaDump = false;
+    long tacRegs = -1; // -1    tN
+    bool runTac = false; //   tac.txt
+    bool useVm = false;
+    bool useAot = false;
+    bool parExec = false; // --parallel:    --jobs 
+    Lanes::Inputs inputs; // --set, --csv:    
+    bool serialRows = false; //      
+    IO::Digits digits = IO::Digits::Twelve; // --shortest:    
+    long benchRuns = 0;
+    std::string benchJson; // --bench-json:    ("-"  stdout)
+    std::string regress; // --regress / --regress-record:  
+    bool regressRecord = false;
+    bool selfTest = false; // --self-test:      
+    int regressSamples = 7;
+    bool trace = false; // --trace: 䳿   stderr
+    long jobs = 0; //   --tac  --batch: 0   , 1  
+    std::string batch; //    
+    std::string serve, connect; //   ( "-"    stdin/stdout)
+    std::string request; // --connect:      
+    std::uint64_t maxSteps = 0, maxOutput = 0;
+    std::string cacheDir = ".lab3cache";
+    std::uintmax_t cacheMax = 64u << 20;
     std::string inputFile;
+};
 
-    for (int i = 1; i < argc; ++i) {
-        std::string a = argv[i];
-        if (a == "--ast") emitDot = true;
-        else if (a == "--tac") emitTac = true;
-        else inputFile = a;
+static bool readFile(const std::string& path, std::string& out) {
+    FILE* f = nullptr;
+#ifdef _MSC_VER
+    if (fopen_s(&f, path.c_str(), "rb") != 0) f = nullptr;
+#else
+    f = std::fopen(path.c_str(), "rb");
+#endif
+    if (!f) return false;
+    out = readAll(f);
+    std::fclose(f);
+    return true;
+}
+
+//  AST (--cache)   :   flex/bison  .
+// errors == nullptr      stderr,   Lab3::parse.
+static Lab3::Program loadProgram(const Options& o, const ASTCache::Store& cache,
+    const std::string& source, bool& cacheHit, std::string* errors = nullptr) {
+    std::uint64_t key = ASTCache::hashBytes(source.data(), source.size());
+    cacheHit = false;
+    std::unique_ptr<AST::Block> program;
+    if (o.useCache) {
+        Mem::Scope phase(Mem::Phase::Cache);
+        program = cache.load(key, source);
+        cacheHit = program != nullptr;
+    }
+    if (!program) {
+        {
+            Mem::Scope phase(Mem::Phase::Parse);
+            program = Lab3::parse(source, errors);
+        }
+        Mem::Scope phase(Mem::Phase::Cache);
+        if (program && o.useCache) cache.save(key, source, *program);
+    }
+    return Lab3::Program::adopt(std::move(program));
+}
+
+static Lab3::RunOptions runOptions(const Options& o, std::ostream* out) {
+    Lab3::RunOptions ro;
+    ro.engine = o.useVm ? Lab3::Engine::VM : Lab3::Engine::Tree;
+    ro.optimize = o.tacOpt;
+    ro.out = out;
+    ro.maxSteps = o.maxSteps;
+    ro.maxOutput = o.maxOutput;
+    ro.threads = o.parExec ? static_cast<unsigned>(o.jobs) : 1;
+    ro.digits = o.digits;
+    return ro;
+}
+
+//     main:  --batch  ,    
+static void traceTo(Lab3::RunOptions& ro, const Options& o, TraceText& text) {
+    if (o.trace) ro.trace = &text;
+}
+
+// --tac-opt, --ssa, --tac-regs   Unit;    log
+static bool tacPasses(TAC::Unit& unit, const Options& o, const std::string& ssaPath, std::ostream& log) {
+    if (o.tacOpt) {
+        TAC::Optimizer opt(unit);
+        opt.run();
+        auto& st = opt.stats;
+        log << "TAC opt: " << st.before << " -> " << st.after << " instructions ("
+            << (st.before - st.after) << " removed; folded " << st.folded << ", propagated "
+            << st.propagated << ", coalesced " << st.coalesced << ", dead " << st.dead
+            << "; threaded " << st.threaded << ", inverted " << st.inverted << ", labels " << st.labels
+            << ", jumps " << st.jumps << ", unreachable " << st.unreachable << ", reordered " << st.reordered << ")\n";
     }
+    if (o.useSsa && !unit.functions.empty()) log << "SSA skipped: program has functions\n";
+    else if (o.useSsa) {
+        TAC::SSA ssa(unit);
+        ssa.build();
+        if (o.ssaDump) {
+            std::ofstream sf(ssaPath);
+            if (!sf) { log << "Cannot open " << ssaPath << "\n"; return false; }
+            IO::Writer sw(sf);
+            ssa.write(sw);
+            log << "SSA written to " << ssaPath << "\n";
+        }
+        ssa.destroy();
+    }
+    if (o.tacRegs >= 0) {
+        TAC::TempAllocator ra(unit, static_cast<std::uint32_t>(o.tacRegs));
+        ra.run();
+        auto& st = ra.stats;
+        log << "Temps: " << st.temps << " distinct, max live " << st.maxLive << ", "
+            << st.regs << " registers, " << st.spilled << " spilled into " << st.slots << " slots\n";
+    }
+    return true;
+}
+
+// ----------  ----------
+// stdout   :   
+static bool shared(const Options& o) {
+    return (o.emitDot ? 1 : 0) + (o.emitTac ? 1 : 0) + (o.runExec ? 1 : 0) > 1;
+}
 
-    if (!inputFile.empty()) {
-        FILE* f = nullptr;
+//    :   stdout,   stderr,  
+struct JobResult {
+    std::string out, err;
+    int code = 0;
+};
+
+static bool writeTac(const Options& o, const Lab3::Program& program, IO::Writer& out,
+    const std::string& ssaPath, std::ostream& log) {
+    TAC::Emitter em;
+    TAC::ParallelEmitter pe;
+    em.unit.digits = pe.digits = o.digits;
+    DAG::Graph dag;
+    if (o.useDag) {
+        dag.build(&program.ast());
+        em.dag = pe.dag = &dag;
+    }
+    //   SSA   ,     
+    bool whole = o.tacOpt || o.useSsa || o.tacRegs >= 0;
+    pe.threads = static_cast<unsigned>(o.jobs);
+    bool par = o.jobs != 1 && pe.gen(&program.ast());
+    if (par) {
+        if (whole) em.unit = pe.merge();
+        em.emitted = pe.emitted;
+    }
+    else {
+        if (!whole) em.sink = &out;
+        em.gen(&program.ast());
+    }
+    if (!tacPasses(em.unit, o, ssaPath, log)) return false;
+    if (whole) em.write(out);
+    else if (par) pe.write(out);
+    if (o.useDag) {
+        log << "DAG: " << dag.treeNodes << " expr nodes (" << dag.treeBytes << " bytes) -> "
+            << dag.nodes.size() << " shared (" << dag.dagBytes() << " bytes), "
+            << em.emitted << " TAC lines\n";
+    }
+    return true;
+}
+
+// DOT  TAC     stdout ("-").  stdout   ,
+//    out    ,   .
+static JobResult writeArtifact(const Options& o, const Lab3::Program& program, bool dot,
+    const std::string& path, const std::string& ssaPath, bool shareStdout) {
+    Mem::Scope phase(dot ? Mem::Phase::Dot : Mem::Phase::Tac);
+    JobResult r;
+    std::ostringstream err, text;
+    const bool toStdout = path == "-";
+    FILE* f = toStdout ? stdout : nullptr;
+    if (!toStdout) {
 #ifdef _MSC_VER
-        if (fopen_s(&f, inputFile.c_str(), "rb") != 0 || !f) {
-            std::cerr << "Cannot open input file: " << inputFile << "\n";
-            return 1;
-        }
+        if (fopen_s(&f, path.c_str(), "w") != 0) f = nullptr;
 #else
-        f = std::fopen(inputFile.c_str(), "rb");
+        f = std::fopen(path.c_str(), "w");
+#endif
         if (!f) {
-            std::cerr << "Cannot open input file: " << inputFile << "\n";
-            return 1;
+            r.err = "Cannot open " + path + " for writing\n";
+            r.code = 3;
+            return r;
         }
-#endif
-        yyin = f;
-        if (!yyin) {
-            std::cerr << "Cannot open input file: " << inputFile << "\n";
+    }
+    bool ok = true, done = true;
+    {
+        //  :        
+        std::optional<IO::Writer> out;
+        if (toStdout && shareStdout) out.emplace(text);
+        else out.emplace(f);
+        IO::Writer& w = *out;
+        w.digits = o.digits;
+        if (dot) AST::writeDOT(program.ast(), w);
+        else done = writeTac(o, program, w, ssaPath, err);
+        ok = w.flush();
+    }
+    if (!toStdout) ok = std::fclose(f) == 0 && ok;
+    r.err = err.str();
+    if (!done) { r.code = 3; return r; }
+    if (!ok) {
+        r.err += "Cannot write " + path + "\n";
+        r.code = 3;
+        return r;
+    }
+    r.out = toStdout ? text.str() : std::string(dot ? "AST written to " : "TAC written to ") + path + "\n";
+    return r;
+}
+
+//  (, --vm  --aot):     out,    r.err
+static JobResult runProgram(const Options& o, const Lab3::Program& program, std::ostream& out, unsigned threads) {
+    Mem::Scope phase(Mem::Phase::Exec);
+    JobResult r;
+    std::ostringstream err;
+    auto finish = [&](int code) {
+        r.err = err.str(); r.code = code;
+        return r;
+    };
+    // ǳ        :      VM
+    if (o.useAot && (o.maxSteps || o.maxOutput)) {
+        err << "Runtime error: --steps and --max-output need the tree or VM engine, not --aot\n";
+        return finish(4);
+    }
+    //   VM, aot    :  ScopeCheck   .
+    //  emitC  쳺     .
+    bool aot = o.useAot && program.staticScopes();
+    if (o.useAot && !aot && o.timing) err << "aot: skipped, scope errors possible; tree interpreter\n";
+    TAC::Unit unit;
+    if (aot) {
+        unit = Lab3::lower(&program.ast(), o.tacOpt);
+        aot = AOT::Builder::supports(unit);
+        if (!aot && o.timing) err << "aot: skipped, functions are not compiled; tree interpreter\n";
+    }
+    if (aot) {
+        AOT::Module mod;
+        AOT::Builder b{ o.cacheDir };
+        auto t0 = std::chrono::steady_clock::now();
+        try {
+            mod = b.build(std::move(unit));
+        }
+        catch (const std::exception& ex) {
+            err << "AOT build failed: " << ex.what() << "\n";
+            return finish(5);
+        }
+        if (o.timing) {
+            std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - t0;
+            err << "aot: " << dt.count() << " ms (" << (b.hit ? "cache hit" : "compiled") << ")\n";
+        }
+        try {
+            mod.run(out, o.digits);
+        }
+        catch (const std::exception& ex) {
+            err << "Runtime error: " << ex.what() << "\n";
+            return finish(4);
+        }
+        return finish(0);
+    }
+    auto ro = runOptions(o, &out);
+    ro.threads = threads;
+    TraceText text(std::cerr);
+    traceTo(ro, o, text);
+    auto res = Lab3::run(program, ro);
+    if (!res.ok()) {
+        err << "Runtime error: " << res.error << "\n";
+        return finish(4);
+    }
+    return finish(0);
+}
+
+// ---------- --memo ----------
+//   :  , , --bench  --trace (䳿   stderr)
+static bool memoizable(const Options& o) {
+    return o.memo && !o.noMemo && o.runExec && !o.emitDot && !o.emitTac &&
+        o.inputs.names.empty() && o.benchRuns == 0 && !o.trace;
+}
+
+static Memo::Key memoKey(const Options& o, const std::string& source) {
+    //   ,    runProgram: --aot   --vm
+    auto engine = o.useAot ? Memo::Engine::Aot : o.useVm ? Memo::Engine::VM : Memo::Engine::Tree;
+    return Memo::key(source, o.digits, o.maxSteps, o.maxOutput, engine, o.tacOpt);
+}
+
+//   ,     ( 4)    --memo-errors
+static void remember(const Options& o, const Memo::Store& memo, const Memo::Key& key, const JobResult& r, std::string out) {
+    if (r.code != 0 && !(r.code == 4 && o.memoErrors)) return;
+    Memo::Entry e;
+    e.code = r.code;
+    e.out = std::move(out);
+    if (r.code) e.err = r.err.substr(std::min(r.err.find("Runtime error: "), r.err.size())); //   --timing
+    memo.save(key, e);
+}
+
+//     ,    --memo-errors
+static bool recall(const Options& o, const Memo::Store& memo, const Memo::Key& key, Memo::Entry& e) {
+    return memo.load(key, e) && (e.code == 0 || o.memoErrors);
+}
+
+// ---------- --batch ----------
+//   :  Context  ,  ,  .
+//      (path.dot, path.tac).
+static JobResult runJob(const Options& o, const ASTCache::Store& cache, const std::string& path) {
+    JobResult r;
+    std::string source;
+    if (!readFile(path, source)) { r.err = "Cannot open input file: " + path + "\n"; r.code = 1; return r; }
+    const Memo::Store memo{ cache };
+    const bool memoize = memoizable(o);
+    const Memo::Key key = memoize ? memoKey(o, source) : Memo::Key{};
+    Memo::Entry e;
+    if (memoize && recall(o, memo, key, e)) {
+        r.out = std::move(e.out); r.err = std::move(e.err); r.code = e.code;
+        return r;
+    }
+    bool hit = false;
+    std::string errors; //  stderr    ,   
+    auto program = loadProgram(o, cache, source, hit, &errors);
+    if (!program) { r.err = errors + "Parsing failed.\n"; r.code = 2; return r; }
+
+    Options one = o;
+    one.jobs = 1; //     
+    one.trace = false;
+    auto add = [&](JobResult part) {
+        r.out += part.out;
+        r.err += part.err;
+        if (r.code == 0) r.code = part.code;
+        return part.code == 0;
+    };
+    if (o.emitDot && !add(writeArtifact(one, program, true, path + ".dot", "", false))) return r;
+    if (o.emitTac && !add(writeArtifact(one, program, false, path + ".tac", path + ".ssa.txt", false))) return r;
+    if (o.runExec) {
+        std::ostringstream out;
+        auto part = runProgram(one, program, out, 1);
+        if (memoize) remember(o, memo, key, part, out.str());
+        r.out += out.str();
+        add(std::move(part));
+    }
+    return r;
+}
+
+//  ->  *.prog   ( );    ,    
+static bool batchFiles(const std::string& from, std::vector<std::string>& files) {
+    std::error_code ec;
+    if (std::filesystem::is_directory(from, ec)) {
+        for (auto& de : std::filesystem::directory_iterator(from, ec))
+            if (de.is_regular_file(ec) && de.path().extension() == ".prog") files.push_back(de.path().string());
+        std::sort(files.begin(), files.end());
+        return !ec;
+    }
+    std::string list;
+    if (!readFile(from, list)) return false;
+    std::istringstream in(list);
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) files.push_back(line);
+    }
+    return true;
+}
+
+//     ,    
+static int runBatch(const Options& o) {
+    std::vector<std::string> files;
+    if (!batchFiles(o.batch, files)) {
+        std::cerr << "Cannot read batch list: " << o.batch << "\n";
+        return 1;
+    }
+    auto started = std::chrono::steady_clock::now();
+    ASTCache::Store cache{ o.cacheDir, o.cacheMax };
+    cache.autoEvict = false; //        
+
+    std::vector<JobResult> results(files.size());
+    std::vector<char> done(files.size(), 0);
+    std::size_t next = 0, failed = 0;
+    int worst = 0;
+    std::mutex printMutex;
+    unsigned threads = Pool::threads(static_cast<unsigned>(o.jobs));
+
+    Pool::forEach(files.size(), threads, [&](std::size_t i) {
+        auto r = runJob(o, cache, files[i]);
+        std::lock_guard<std::mutex> lock(printMutex);
+        results[i] = std::move(r);
+        done[i] = 1;
+        for (; next < files.size() && done[next]; ++next) {
+            auto& d = results[next];
+            std::cout << "==> " << files[next] << " <==\n" << d.out;
+            if (d.code != 0) {
+                std::cout.flush();
+                std::istringstream lines(d.err);
+                for (std::string line; std::getline(lines, line);) std::cerr << files[next] << ": " << line << "\n";
+                ++failed;
+                if (d.code > worst) worst = d.code;
+            }
+            d = JobResult{};
+        }
+        std::cout.flush();
+    });
+    if (o.useCache) cache.evict();
+
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - started;
+    std::cerr << "batch: " << files.size() << " files (" << failed << " failed) in " << dt.count() * 1000 << " ms, "
+        << (dt.count() > 0 ? files.size() / dt.count() : 0.0) << " files/s on " << threads << " threads\n";
+    return worst;
+}
+
+// ---------- --serve ----------
+static Serve::Response serveRequest(const Serve::Request& rq, Serve::Warm<Lab3::Compiled>& warm) {
+    Serve::Response rs;
+    const bool exec = rq.mode == "exec", vm = rq.mode == "vm", tac = rq.mode == "tac", ast = rq.mode == "ast";
+    if (!exec && !vm && !tac && !ast) {
+        rs.status = 6;
+        rs.err = "Bad request: unknown mode '" + rq.mode + "'\n";
+        return rs;
+    }
+
+    std::string parseErrors;
+    auto shared = warm.get(rq.source, [&]() {
+        return Lab3::compile(rq.source, &parseErrors).shared();
+    });
+    Lab3::Program prog(shared);
+    if (!prog) {
+        rs.status = 2;
+        rs.err = parseErrors + "Parsing failed.\n";
+        return rs;
+    }
+
+    if (ast || tac) {
+        std::ostringstream text;
+        {
+            IO::Writer w(text);
+            if (ast) AST::writeDOT(prog.ast(), w);
+            else {
+                TAC::Emitter em;
+                em.sink = &w;
+                em.gen(&prog.ast());
+            }
+        }
+        rs.out = text.str();
+        if (rq.maxOutput && rs.out.size() > rq.maxOutput) {
+            rs.out.resize(rq.maxOutput);
+            rs.status = 4;
+            rs.err = "Runtime error: output limit exceeded\n";
+        }
+        return rs;
+    }
+
+    Lab3::RunOptions ro;
+    ro.engine = vm ? Lab3::Engine::VM : Lab3::Engine::Tree;
+    ro.maxSteps = rq.maxSteps;
+    ro.maxOutput = rq.maxOutput;
+    auto r = Lab3::run(prog, ro);
+    rs.out = std::move(r.out);
+    rs.status = r.status;
+    if (!r.ok()) rs.err = "Runtime error: " + r.error + "\n";
+    return rs;
+}
+
+static int runServer(const Options& o) {
+    Serve::Warm<Lab3::Compiled> warm;
+    Serve::Server server;
+    server.handle = [&](const Serve::Request& rq) { return serveRequest(rq, warm); };
+    server.extraStats = [&]() {
+        return "cache-hits " + std::to_string(warm.hits.load()) + "\ncache-misses " + std::to_string(warm.misses.load()) + "\n";
+    };
+    int rc = o.serve == "-" ? server.serveStdio() : server.serveSocket(o.serve);
+    std::cerr << server.stats.text() << server.extraStats();
+    return rc;
+}
+
+// 볺:    --serve;         
+static int runClient(const Options& o) {
+    Serve::Request rq;
+    rq.mode = !o.request.empty() ? o.request : o.emitDot ? "ast" : o.emitTac ? "tac" : o.useVm ? "vm" : "exec";
+    rq.maxSteps = o.maxSteps;
+    rq.maxOutput = o.maxOutput;
+    if (rq.mode != "stats" && rq.mode != "shutdown") {
+        if (o.inputFile.empty()) rq.source = readAll(stdin);
+        else if (!readFile(o.inputFile, rq.source)) {
+            std::cerr << "Cannot open input file: " << o.inputFile << "\n";
             return 1;
         }
     }
-    else {
-        yyin = stdin;
+    Serve::Response rs;
+    std::string error;
+    if (!Serve::call(o.connect, rq, rs, error)) {
+        std::cerr << "Cannot reach server: " << error << "\n";
+        return 1;
     }
+    std::cout << rs.out;
+    std::cout.flush();
+    std::cerr << rs.err;
+    if (o.timing) std::cerr << "server: " << rs.micros << " us\n";
+    return rs.status;
+}
 
-    int res = yyparse();
-    yylex_destroy();
+// ---------- --set / --csv ----------
+//      ,    stderr,   --batch
+static int runRows(const Options& o, const Lab3::Program& program) {
+    Mem::Scope phase(Mem::Phase::Exec);
+    auto ro = runOptions(o, nullptr);
+    ro.engine = o.serialRows ? Lab3::Engine::Tree : Lab3::Engine::Lanes;
+    TraceText text(std::cerr);
+    traceTo(ro, o, text);
+    auto started = std::chrono::steady_clock::now();
+    auto results = Lab3::runRows(program, o.inputs, ro);
+    std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - started;
 
-    if (res != 0 || g_root == nullptr) {
-        std::cerr << "Parsing failed.\n";
-        return 2;
+    int worst = 0;
+    std::size_t failed = 0;
+    for (std::size_t r = 0; r < results.size(); ++r) {
+        std::cout << "==>";
+        for (std::size_t k = 0; k < o.inputs.names.size(); ++k)
+            std::cout << ' ' << o.inputs.names[k] << '=' << IO::numberText(o.inputs.at(r, k), o.digits);
+        std::cout << " <==\n" << results[r].out;
+        if (!results[r].ok()) {
+            std::cout.flush();
+            std::cerr << "row " << r + 1 << ": Runtime error: " << results[r].error << "\n";
+            ++failed;
+            worst = std::max(worst, results[r].status);
+        }
+    }
+    std::cout.flush();
+    if (o.timing)
+        std::cerr << "rows: " << results.size() << " (" << failed << " failed) in " << dt.count() << " ms, "
+            << (o.serialRows ? "one by one" : "lanes") << "\n";
+    return worst;
+}
+
+// ---------- --bench ----------
+//  --bench: ms     
+struct BenchPhase {
+    const char* name;
+    Perf::Sample per;
+};
+
+static void writeBenchJson(std::ostream& out, long runs, const Perf::Counters& pc, const std::vector<BenchPhase>& phases) {
+    out << "{\n  \"runs\": " << runs << ",\n  \"counters\": " << (pc.available() ? "true" : "false");
+    if (!pc.available()) {
+        out << ",\n  \"note\": \"";
+        for (char c : pc.why) out << (c == '"' || c == '\\' ? '_' : c);
+        out << '"';
+    }
+    out << ",\n  \"phases\": [";
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        auto& p = phases[i];
+        out << (i ? "," : "") << "\n    { \"name\": \"" << p.name << "\", \"ms\": " << IO::numberText(p.per.ms, IO::Digits::Shortest);
+        for (int e = 0; e < Perf::EventCount; ++e) {
+            out << ", \"" << Perf::eventName(e) << "\": ";
+            if (p.per.have[e]) out << p.per.values[e];
+            else out << "null";
+        }
+        out << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+//    : , , DOT, TAC, , VM ( --trace, --aot).
+//  ;   perf_event_open,   .
+static int runBench(const Options& o, const std::string& source, const Lab3::Program& program) {
+    using Ms = std::chrono::duration<double, std::milli>;
+    NullBuf nb;
+    std::ostream sink(&nb);
+    Perf::Counters pc;
+    std::vector<BenchPhase> phases;
+    auto phase = [&](const char* name, auto&& body) {
+        auto s = pc.measure([&]() { for (long r = 0; r < o.benchRuns; ++r) body(); });
+        s.ms /= static_cast<double>(o.benchRuns);
+        for (auto& v : s.values) v /= static_cast<std::uint64_t>(o.benchRuns);
+        phases.push_back({ name, s });
+        return s.ms;
+    };
+    try {
+        std::size_t tokens = 0;
+        phase("lex", [&]() { tokens = Lab3::lex(source); });
+        phase("parse", [&]() { Lab3::parse(source); });
+        phase("dot", [&]() { AST::writeDOT(program.ast(), sink); });
+        phase("tac", [&]() {
+            IO::Writer w(sink);
+            TAC::Emitter em;
+            em.sink = &w;
+            em.gen(&program.ast());
+        });
+        double tree = phase("exec", [&]() {
+            AST::Context ctx;
+            ctx.out = &sink;
+            program.ast().exec(ctx);
+        });
+        // VM  aot    ScopeCheck ,    ,   
+        const bool lowered = program.staticScopes();
+        TAC::Unit unit;
+        if (!lowered) std::cerr << "vm: skipped, scope errors possible (only the tree reports them)\n";
+        else {
+            auto t1 = std::chrono::steady_clock::now();
+            unit = Lab3::lower(&program.ast(), o.tacOpt);
+            auto vm = VM::Program::compile(unit);
+            auto t2 = std::chrono::steady_clock::now();
+            std::vector<double> regs;
+            double reg = phase("vm", [&]() { VM::run(vm, regs, sink); });
+
+            std::cerr << "exec: " << tree << " ms/run, vm: " << reg << " ms/run (x" << tree / reg
+                << "), TAC + compile " << Ms(t2 - t1).count() << " ms, " << vm.code.size() << " VM instructions\n";
+        }
+        if (o.trace) {
+            // ֳ Recorder   Sink;  --trace    NoTrace
+            struct Count : Trace::Sink {
+                std::uint64_t n = 0;
+                void event(const Trace::Event&) override { ++n; }
+            } count;
+            double traced = phase("trace", [&]() {
+                AST::TraceContext ctx;
+                ctx.out = &sink;
+                ctx.sink = &count;
+                program.ast().exec(ctx);
+            });
+            std::cerr << "trace: " << traced << " ms/run (x" << traced / tree << " of exec), "
+                << count.n / static_cast<std::uint64_t>(o.benchRuns) << " events/run\n";
+        }
+        if (o.useAot && lowered && !AOT::Builder::supports(unit)) std::cerr << "aot: skipped, functions are not compiled\n";
+        if (o.useAot && lowered && AOT::Builder::supports(unit)) {
+            AOT::Builder b{ o.cacheDir };
+            auto t4 = std::chrono::steady_clock::now();
+            auto mod = b.build(unit);
+            auto t5 = std::chrono::steady_clock::now();
+            double native = phase("aot", [&]() { mod.run(sink); });
+            std::cerr << "aot: " << native << " ms/run (x" << tree / native << "), build "
+                << Ms(t5 - t4).count() << " ms (" << (b.hit ? "cache hit" : "compiled") << ")\n";
+        }
+
+        char line[200];
+        std::cerr << "lex: " << tokens << " tokens; counters: " << (pc.available() ? "perf_event_open" : pc.why) << "\n";
+        for (auto& p : phases) {
+            int n = std::snprintf(line, sizeof line, "phase: %-6s %12.4f ms", p.name, p.per.ms);
+            for (int e = 0; e < Perf::EventCount && n < static_cast<int>(sizeof line); ++e)
+                if (p.per.have[e])
+                    n += std::snprintf(line + n, sizeof line - n, " %s=%llu", Perf::eventName(e),
+                        static_cast<unsigned long long>(p.per.values[e]));
+            std::cerr << line << "\n";
+        }
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Runtime error: " << ex.what() << "\n";
+        return 4;
+    }
+
+    if (!o.benchJson.empty()) {
+        if (o.benchJson == "-") writeBenchJson(std::cout, o.benchRuns, pc, phases);
+        else {
+            std::ofstream f(o.benchJson, std::ios::binary);
+            writeBenchJson(f, o.benchRuns, pc, phases);
+            if (!f) {
+                std::cerr << "Cannot write " << o.benchJson << "\n";
+                return 3;
+            }
+        }
+    }
+    return 0;
+}
+
+// ---------- --regress ----------
+//      ( )  ; 7   .
+// --regress-record  ,     .
+static int runRegress(const Options& o) {
+    std::vector<Regress::Entry> base;
+    std::string text, error;
+    bool haveBase = readFile(o.regress, text);
+    if (haveBase && !Regress::parseBaseline(text, base, error)) {
+        std::cerr << o.regress << ": " << error << "\n";
+        return 1;
+    }
+    if (!haveBase && !o.regressRecord) {
+        std::cerr << "Cannot open baseline: " << o.regress << "\n";
+        return 1;
+    }
+
+    auto cases = Regress::corpus();
+    if (!o.inputFile.empty()) {
+        Regress::Case c;
+        c.name = std::filesystem::path(o.inputFile).filename().string();
+        if (!readFile(o.inputFile, c.source)) {
+            std::cerr << "Cannot open input file: " << o.inputFile << "\n";
+            return 1;
+        }
+        cases.push_back(std::move(c));
+    }
+
+    Regress::Options ro;
+    ro.samples = o.regressSamples;
+    ro.cacheDir = o.cacheDir;
+    std::vector<Lab3::Program> programs; // ,   
+    std::vector<Regress::Bench> benches;
+    std::vector<std::string> skipped;
+    benches.push_back({ Regress::calibrationName, Regress::calibration });
+    for (auto& c : cases) {
+        std::string errors;
+        auto program = Lab3::compile(c.source, &errors);
+        if (!program) {
+            std::cerr << c.name << ": parsing failed\n" << errors;
+            return 2;
+        }
+        programs.push_back(program);
+        Regress::benches(c, programs.back(), ro, benches, skipped);
     }
 
-    std::unique_ptr<AST::Block> program(g_root); //  
+    std::vector<Regress::Entry> now;
+    try {
+        Regress::measure(benches, ro.samples, ro.minMs);
+        for (auto& b : benches) {
+            Regress::Entry e;
+            e.name = b.name;
+            e.ms = Regress::median(b.ms);
+            auto old = std::find_if(base.begin(), base.end(), [&](const Regress::Entry& x) { return x.name == e.name; });
+            if (old != base.end()) e.tolerance = old->tolerance;
+            now.push_back(e);
+            if (o.timing) std::cerr << "regress: " << e.name << " " << e.ms << " ms\n";
+        }
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Runtime error: " << ex.what() << "\n";
+        return 4;
+    }
+    for (auto& s : skipped) std::cerr << "skipped " << s << "\n";
 
-    if (emitDot) {
-        std::ofstream out("ast.dot");
-        if (!out) {
-            std::cerr << "Cannot open ast.dot for writing\n";
+    if (o.regressRecord) {
+        std::ofstream f(o.regress, std::ios::binary);
+        Regress::writeBaseline(f, now);
+        if (!f) {
+            std::cerr << "Cannot write " << o.regress << "\n";
             return 3;
         }
-        AST::writeDOT(*program, out);
-        std::cout << "AST written to ast.dot\n";
+        std::cout << "Baseline written to " << o.regress << " (" << now.size() << " benchmarks)\n";
         return 0;
     }
-    else if (emitTac) {                                // 
-        std::ofstream out("tac.txt");
-        if (!out) { std::cerr << "Cannot open tac.txt\n"; return 3; }
-        TAC::Emitter em;
-        em.gen(program.get());
-        em.write(out);
-        std::cout << "TAC written to tac.txt\n";
-        return 0;
+    int bad = Regress::compare(std::cout, base, now);
+    std::cout << (bad ? std::to_string(bad) + " regression(s)\n" : std::string("no regressions\n"));
+    return bad ? 7 : 0;
+}
+
+// ---------- --self-test ----------
+// 8   
+static int runSelfTest(const Options& o) {
+    int failed = SelfTest::engines(std::cout, o.cacheDir);
+    Serve::Warm<Lab3::Compiled> warm;
+    failed += SelfTest::server(std::cout, [&](const Serve::Request& rq) { return serveRequest(rq, warm); });
+    std::cout << (failed ? std::to_string(failed) + " check(s) failed\n" : std::string("all checks passed\n"));
+    return failed ? 8 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    auto started = std::chrono::steady_clock::now();
+    Options o;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--ast") o.emitDot = true;
+        else if (a == "--tac") { o.emitTac = true; o.tacExplicit = true; }
+        else if (a == "--dag") o.useDag = true;
+        else if (a == "--cache") o.useCache = true;
+        else if (a == "--no-cache") o.useCache = false;
+        else if (a == "--memo") o.memo = true;
+        else if (a == "--memo-errors") { o.memo = true; o.memoErrors = true; }
+        else if (a == "--no-memo") o.noMemo = true;
+        else if (a == "--cache-dir" && i + 1 < argc) o.cacheDir = argv[++i];
+        else if (a == "--cache-max" && i + 1 < argc) o.cacheMax = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--timing") o.timing = true;
+        else if (a == "--stdout") o.toStdout = true;
+        else if (a == "--ast-out" && i + 1 < argc) { o.emitDot = true; o.dotPath = argv[++i]; }
+        else if (a == "--tac-out" && i + 1 < argc) { o.emitTac = true; o.tacExplicit = true; o.tacPath = argv[++i]; }
+        else if (a == "--exec") o.runExec = true;
+        else if (a == "--mem-stats") o.memStats = true;
+        else if (a == "--tac-opt") { o.emitTac = true; o.tacOpt = true; }
+        else if (a == "--ssa") { o.emitTac = true; o.useSsa = true; }
+        else if (a == "--ssa-dump") { o.emitTac = true; o.useSsa = true; o.ssaDump = true; }
+        else if (a == "--tac-regs" && i + 1 < argc) { o.emitTac = true; o.tacRegs = std::strtol(argv[++i], nullptr, 10); }
+        else if (a == "--run-tac") o.runTac = true;
+        else if (a == "--vm") o.useVm = true;
+        else if (a == "--aot") o.useAot = true;
+        else if (a == "--parallel") o.parExec = true;
+        else if ((a == "--set" || a == "--csv") && i + 1 < argc) {
+            std::string spec = argv[++i], text, error;
+            bool ok = a == "--set" ? o.inputs.set(spec, error)
+                : readFile(spec, text) ? o.inputs.csv(text, error)
+                : (error = "cannot open " + spec, false);
+            if (!ok) {
+                std::cerr << a << ": " << error << "\n";
+                return 1;
+            }
+        }
+        else if (a == "--serial-rows") o.serialRows = true;
+        else if (a == "--shortest") o.digits = IO::Digits::Shortest;
+        else if (a == "--trace") o.trace = true;
+        else if (a == "--jobs" && i + 1 < argc) o.jobs = std::strtol(argv[++i], nullptr, 10);
+        else if (a == "--bench" && i + 1 < argc) o.benchRuns = std::strtol(argv[++i], nullptr, 10);
+        else if (a == "--bench-json" && i + 1 < argc) o.benchJson = argv[++i];
+        else if ((a == "--regress" || a == "--regress-record") && i + 1 < argc) { o.regress = argv[++i]; o.regressRecord = a == "--regress-record"; }
+        else if (a == "--regress-samples" && i + 1 < argc) o.regressSamples = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--self-test") o.selfTest = true;
+        else if (a == "--batch" && i + 1 < argc) o.batch = argv[++i];
+        else if (a == "--serve" && i + 1 < argc) o.serve = argv[++i];
+        else if (a == "--connect" && i + 1 < argc) o.connect = argv[++i];
+        else if (a == "--request" && i + 1 < argc) o.request = argv[++i];
+        else if (a == "--steps" && i + 1 < argc) o.maxSteps = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--max-output" && i + 1 < argc) o.maxOutput = std::strtoull(argv[++i], nullptr, 10);
+        else o.inputFile = a;
+    }
+    //  --vm/--aot/--bench  TAC ,     tac.txt,
+    //   TAC   (--tac, --tac-out)
+    if ((o.useVm || o.useAot || o.benchRuns > 0) && !o.tacExplicit) o.emitTac = false;
+    if (o.useVm || o.useAot || (!o.emitDot && !o.emitTac)) o.runExec = true;
+    if (o.toStdout) o.dotPath = o.tacPath = "-";
+
+    //    -   main
+    struct MemReport {
+        bool on;
+        ~MemReport() { if (on) Mem::report(std::cerr); }
+    } memReport{ o.memStats };
+    if (o.memStats) Mem::enable();
+
+    if (!o.batch.empty()) return runBatch(o);
+    if (!o.serve.empty()) return runServer(o);
+    if (!o.connect.empty()) return runClient(o);
+    if (!o.regress.empty()) return runRegress(o);
+    if (o.selfTest) return runSelfTest(o);
+
+    std::string source;
+    if (!o.inputFile.empty()) {
+        if (!readFile(o.inputFile, source)) {
+            std::cerr << "Cannot open input file: " << o.inputFile << "\n";
+            return 1;
+        }
     }
     else {
-        AST::Context ctx;
+        source = readAll(stdin);
+    }
+
+    if (o.runTac) {
+        VM::Program vm;
+        try {
+            TAC::Loader ld;
+            ld.load(source.data(), source.size());
+            vm = VM::Program::compile(ld.unit);
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "Cannot load TAC: " << ex.what() << "\n";
+            return 2;
+        }
         try {
-            program->exec(ctx);
+            VM::run(vm, std::cout, 0, o.digits);
         }
         catch (const std::exception& ex) {
             std::cerr << "Runtime error: " << ex.what() << "\n";
             return 4;
         }
+        return 0;
+    }
+
+    ASTCache::Store cache{ o.cacheDir, o.cacheMax };
+    //    :  ,  
+    const Memo::Store memo{ cache };
+    const bool memoize = memoizable(o);
+    const Memo::Key key = memoize ? memoKey(o, source) : Memo::Key{};
+    if (memoize) {
+        Memo::Entry e;
+        if (recall(o, memo, key, e)) {
+            std::cout.write(e.out.data(), static_cast<std::streamsize>(e.out.size()));
+            std::cout.flush();
+            std::cerr << e.err;
+            if (o.timing) {
+                std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - started;
+                std::cerr << "memo: hit, " << e.out.size() << " bytes replayed in " << dt.count() << " ms\n";
+            }
+            return e.code;
+        }
     }
 
-    return 0;
+    bool cacheHit = false;
+    auto program = loadProgram(o, cache, source, cacheHit);
+    if (!program) {
+        std::cerr << "Parsing failed.\n";
+        return 2;
+    }
+
+    if (o.memStats) {
+        Mem::AstFootprint fp;
+        fp.stmt(&program.ast());
+        fp.write(std::cerr);
+    }
+
+    if (o.timing) {
+        std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - started;
+        std::cerr << "startup: " << dt.count() << " ms ("
+            << (!o.useCache ? "no cache" : cacheHit ? "cache hit" : "cache miss") << ")\n";
+    }
+
+    if (!o.inputs.names.empty() && !o.emitDot && !o.emitTac) return runRows(o, program);
+
+    if (o.benchRuns > 0) return runBench(o, source, program);
+
+    //    -  DOT, TAC  ;   
+    Memo::Tee tee(&std::cout, memo.entryMax());
+    std::ostream teeOut(&tee);
+    std::ostream& execOut = memoize ? teeOut : std::cout;
+    std::vector<std::function<JobResult()>> parts;
+    const char* names[3] = {};
+    if (o.emitDot) { names[parts.size()] = "dot"; parts.push_back([&]() { return writeArtifact(o, program, true, o.dotPath, "", shared(o)); }); }
+    if (o.emitTac) { names[parts.size()] = "tac"; parts.push_back([&]() { return writeArtifact(o, program, false, o.tacPath, "ssa.txt", shared(o)); }); }
+    if (o.runExec) { names[parts.size()] = "exec"; parts.push_back([&]() { return runProgram(o, program, execOut, o.parExec ? static_cast<unsigned>(o.jobs) : 1); }); }
+
+    std::vector<JobResult> results(parts.size());
+    std::vector<double> ms(parts.size());
+    Pool::forEach(parts.size(), o.jobs == 1 ? 1 : static_cast<unsigned>(parts.size()), [&](std::size_t i) {
+        auto t0 = std::chrono::steady_clock::now();
+        results[i] = parts[i]();
+        ms[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    });
+
+    int code = 0;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        std::cerr << results[i].err; // cerr '  cout:    
+        std::cout << results[i].out;
+        std::cout.flush();
+        if (o.timing && parts.size() > 1) std::cerr << names[i] << ": " << ms[i] << " ms\n";
+        code = std::max(code, results[i].code);
+    }
+    if (memoize && !tee.over) remember(o, memo, key, results[0], std::move(tee.text));
+    return code;
 }
@@ -9,6 +9,9 @@
 //   AST (Block)
 AST::Block* g_root = nullptr;
 
+//   ,   AST::resolve (, ); 0    
+int g_resolveNodes = 0;
+
 int yylex(void);
 void yyerror(const char* s);
 %}
@@ -17,6 +20,8 @@ void yyerror(const char* s);
 
 %code requires {
   #include <string>
+  #include <vector>
+  #include <utility>
   #include "../include/ast.hpp" /*     parser.hpp */
 }
 
@@ -27,11 +32,13 @@ void yyerror(const char* s);
     AST::Expr* expr;
     AST::Stmt* stmt;
     AST::Block* block;
+    std::vector<AST::Expr*>* args;
+    std::vector<std::pair<AST::Type, std::string>>* params;
     int token;
 }
 
 /*  */
-%token KW_INT KW_DOUBLE KW_IF KW_ELSE KW_WHILE KW_PRINT
+%token KW_INT KW_DOUBLE KW_IF KW_ELSE KW_WHILE KW_PRINT KW_RETURN
 %token <str> IDENT
 %token <num> NUMBER
 %token EQ NE LE GE AND OR
@@ -49,16 +56,25 @@ void yyerror(const char* s);
 %nonassoc KW_ELSE
 
 /*   */
-%type <block> program stmts
-%type <stmt> stmt vardecl assign print if while block
-%type <expr> expr
+%type <block> program stmts items
+%type <stmt> stmt vardecl assign print if while block funcdef return
+%type <expr> expr call
+%type <args> args arglist
+%type <params> params paramlist
 
 %start program
 
 %%
 
 program
-    : stmts                  { g_root = $1; }
+    : items                  { g_root = $1; }
+    ;
+
+/*  :     */
+items
+    : /* empty */            { $$ = new AST::Block(); }
+    | items stmt             { $1->add($2); $$ = $1; }
+    | items funcdef          { $1->add($2); $$ = $1; }
     ;
 
 stmts
@@ -73,6 +89,8 @@ stmt
     | if                      { $$ = $1; }
     | while                   { $$ = $1; }
     | block                   { $$ = $1; }
+    | return                  { $$ = $1; }
+    | call ';'               { $$ = new AST::ExprStmt($1); }
     ;
 
 block
@@ -85,11 +103,53 @@ vardecl
     | KW_DOUBLE IDENT        { $$ = new AST::VarDecl(AST::Type::Double, *$2); delete $2; }
     | KW_INT IDENT '=' expr  { $$ = new AST::VarDecl(AST::Type::Int, *$2, $4); delete $2; }
     | KW_DOUBLE IDENT '=' expr { $$ = new AST::VarDecl(AST::Type::Double, *$2, $4); delete $2; }
+    | KW_INT IDENT '[' NUMBER ']'    { $$ = new AST::ArrayDecl(AST::Type::Int, *$2, $4); delete $2; ++g_resolveNodes; }
+    | KW_DOUBLE IDENT '[' NUMBER ']' { $$ = new AST::ArrayDecl(AST::Type::Double, *$2, $4); delete $2; ++g_resolveNodes; }
+    ;
+
+/* :   ,     vardecl */
+funcdef
+    : KW_INT IDENT '(' params ')' block
+        { $$ = new AST::Function(AST::Type::Int, *$2, $4, static_cast<AST::Block*>($6)); delete $2; ++g_resolveNodes; }
+    | KW_DOUBLE IDENT '(' params ')' block
+        { $$ = new AST::Function(AST::Type::Double, *$2, $4, static_cast<AST::Block*>($6)); delete $2; ++g_resolveNodes; }
+    ;
+
+params
+    : /* empty */            { $$ = new std::vector<std::pair<AST::Type, std::string>>(); }
+    | paramlist              { $$ = $1; }
+    ;
+
+paramlist
+    : KW_INT IDENT           { $$ = new std::vector<std::pair<AST::Type, std::string>>(); $$->emplace_back(AST::Type::Int, *$2); delete $2; }
+    | KW_DOUBLE IDENT        { $$ = new std::vector<std::pair<AST::Type, std::string>>(); $$->emplace_back(AST::Type::Double, *$2); delete $2; }
+    | paramlist ',' KW_INT IDENT    { $1->emplace_back(AST::Type::Int, *$4); delete $4; $$ = $1; }
+    | paramlist ',' KW_DOUBLE IDENT { $1->emplace_back(AST::Type::Double, *$4); delete $4; $$ = $1; }
+    ;
+
+return
+    : KW_RETURN expr ';'     { $$ = new AST::Return($2); ++g_resolveNodes; }
+    | KW_RETURN ';'          { $$ = new AST::Return(nullptr); ++g_resolveNodes; }
+    ;
+
+call
+    : IDENT '(' args ')'     { $$ = new AST::Call(*$1, $3); delete $1; ++g_resolveNodes; }
+    ;
+
+args
+    : /* empty */            { $$ = new std::vector<AST::Expr*>(); }
+    | arglist                { $$ = $1; }
+    ;
+
+arglist
+    : expr                   { $$ = new std::vector<AST::Expr*>(1, $1); }
+    | arglist ',' expr       { $1->push_back($3); $$ = $1; }
     ;
 
 /*  */
 assign
     : IDENT '=' expr         { $$ = new AST::Assign(*$1, $3); delete $1; }
+    | IDENT '[' expr ']' '=' expr { $$ = new AST::IndexAssign(*$1, $3, $6); delete $1; ++g_resolveNodes; }
     ;
 
 /*  */
@@ -130,10 +190,16 @@ expr
     | '(' expr ')'           { $$ = $2; }
     | NUMBER                 { $$ = new AST::Number($1); }
     | IDENT                  { $$ = new AST::Ident(*$1); delete $1; }
+    | IDENT '[' expr ']'     { $$ = new AST::Index(*$1, $3); delete $1; ++g_resolveNodes; }
+    | call                   { $$ = $1; }
     ;
 
 %%
 
+//     (--serve   볺); nullptr   stderr
+std::string* g_parseErrors = nullptr;
+
 void yyerror(const char* s) {
+    if (g_parseErrors) { *g_parseErrors += std::string("Parse error: ") + s + "\n"; return; }
     std::fprintf(stderr, "Parse error: %s\n", s);
 }